@@ -0,0 +1,551 @@
+// Microbenchmarks for the simulation kernels.
+//
+// Each case times one kernel over a matrix of particle counts and
+// resolutions and reports nanoseconds per item (particle, cell, column,
+// segment or sample). Every run starts from the same seed, and --json writes the
+// results in a form that can be diffed across commits.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "DisplayData.h"
+#include "FastNoiseLite.h"
+#include "FastNoiseLiteBatch.h"
+#include "MathUtil.h"
+#include "Puddle.h"
+#include "RainField.h"
+#include "RandomGenerator.h"
+#include "SettledSnow.h"
+#include "SnowField.h"
+#include "SnowFlake.h"
+#include "Splatter.h"
+#include "VersionRC.h"
+
+using namespace RainEngine;
+
+namespace {
+
+constexpr std::uint64_t BENCH_SEED = 20240601;
+constexpr float STEP_SECONDS = 1.0f / 120.0f;
+constexpr int WARMUP_ITERATIONS = 240; // Two simulated seconds, so particles spread out first
+constexpr int REPETITIONS = 5;
+
+struct Resolution {
+    int Width;
+    int Height;
+};
+
+constexpr Resolution RESOLUTIONS[] = {{1920, 1080}, {3840, 2160}};
+constexpr size_t PARTICLE_COUNTS[] = {1000, 10000, 100000};
+
+struct BenchOptions {
+    double MinTimeMs = 100.0;
+    std::string Filter;
+    std::string JsonPath;
+    std::string Label;
+};
+
+struct Param {
+    std::string Name;
+    std::string Value; // Already JSON: a number or a quoted string
+};
+
+struct BenchResult {
+    std::string Name;
+    std::vector<Param> Params;
+    size_t Items = 0;       // Items one iteration processes
+    long long Iterations = 0;
+    double NsPerItem = 0.0; // Median over the repetitions
+    double NsPerItemMin = 0.0;
+};
+
+// A JSON string literal, quotes included, so labels and names can hold any text
+[[nodiscard]] std::string JsonString(const std::string_view text) {
+    std::string quoted = "\"";
+    for (const char c : text) {
+        if (c == '"' || c == '\\') {
+            quoted += '\\';
+            quoted += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escape[8];
+            std::snprintf(escape, sizeof escape, "\\u%04x", static_cast<unsigned>(c));
+            quoted += escape;
+        } else {
+            quoted += c;
+        }
+    }
+    return quoted + "\"";
+}
+
+[[nodiscard]] Param Number(std::string name, const double value) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof buffer, "%.10g", value);
+    return {std::move(name), buffer};
+}
+
+[[nodiscard]] Param Text(std::string name, const std::string_view value) {
+    return {std::move(name), JsonString(value)};
+}
+
+class Bench {
+public:
+    explicit Bench(BenchOptions options) : options_(std::move(options)) {}
+
+    [[nodiscard]] bool Wants(const std::string_view name) const {
+        return options_.Filter.empty() || name.find(options_.Filter) != std::string_view::npos;
+    }
+
+    // Time run() until MinTimeMs has passed in each of REPETITIONS rounds.
+    // prepare() runs untimed before every run(); items() is read after it.
+    void Measure(const std::string& name, std::vector<Param> params, const std::function<size_t()>& items,
+                 const std::function<void()>& prepare, const std::function<void()>& run) {
+        using Clock = std::chrono::steady_clock;
+
+        for (int i = 0; i < WARMUP_ITERATIONS; ++i) {
+            prepare();
+            run();
+        }
+
+        std::vector<double> rounds;
+        long long iterations = 0;
+        size_t lastItems = 0;
+        const double roundNs = options_.MinTimeMs * 1.0e6 / REPETITIONS;
+        for (int round = 0; round < REPETITIONS; ++round) {
+            double timedNs = 0.0;
+            double itemCount = 0.0;
+            while (timedNs < roundNs) {
+                prepare();
+                lastItems = items();
+                const auto start = Clock::now();
+                run();
+                timedNs += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+                itemCount += static_cast<double>(std::max<size_t>(lastItems, 1));
+                ++iterations;
+            }
+            rounds.push_back(timedNs / itemCount);
+        }
+        std::sort(rounds.begin(), rounds.end());
+
+        BenchResult result;
+        result.Name = name;
+        result.Params = std::move(params);
+        result.Items = lastItems;
+        result.Iterations = iterations;
+        result.NsPerItem = rounds[rounds.size() / 2];
+        result.NsPerItemMin = rounds.front();
+
+        if (options_.JsonPath != "-") {
+            std::string label = result.Name;
+            for (const Param& param : result.Params) {
+                label += " " + param.Name + "=" + param.Value;
+            }
+            std::printf("%-72s %10.3f ns/item  (min %.3f, %zu items, %lld iterations)\n", label.c_str(),
+                        result.NsPerItem, result.NsPerItemMin, result.Items, result.Iterations);
+            std::fflush(stdout);
+        }
+        results_.push_back(std::move(result));
+    }
+
+    [[nodiscard]] bool WriteJson() const {
+        if (options_.JsonPath.empty()) return true;
+
+        FILE* file = options_.JsonPath == "-" ? stdout : std::fopen(options_.JsonPath.c_str(), "w");
+        if (!file) {
+            std::fprintf(stderr, "Cannot write %s\n", options_.JsonPath.c_str());
+            return false;
+        }
+
+        const char* simd = "scalar";
+        switch (NoiseBatch::GetSimdLevel()) {
+        case NoiseBatch::SimdLevel::Avx2: simd = "avx2"; break;
+        case NoiseBatch::SimdLevel::Sse2: simd = "sse2"; break;
+        default: break;
+        }
+
+        std::fprintf(file, "{\n  \"benchmark\": \"wthrr-bench\",\n  \"version\": \"%s\",\n", WTHRR_VERSION_STRING);
+        std::fprintf(file, "  \"label\": %s,\n  \"seed\": %llu,\n  \"noise_simd\": \"%s\",\n",
+                     JsonString(options_.Label).c_str(), static_cast<unsigned long long>(BENCH_SEED), simd);
+        std::fprintf(file, "  \"results\": [\n");
+        for (size_t i = 0; i < results_.size(); ++i) {
+            const BenchResult& result = results_[i];
+            std::fprintf(file, "    {\"name\": %s, \"params\": {", JsonString(result.Name).c_str());
+            for (size_t p = 0; p < result.Params.size(); ++p) {
+                std::fprintf(file, "%s%s: %s", p ? ", " : "", JsonString(result.Params[p].Name).c_str(),
+                             result.Params[p].Value.c_str());
+            }
+            std::fprintf(file,
+                         "}, \"items\": %zu, \"iterations\": %lld, \"ns_per_item\": %.4f, \"ns_per_item_min\": %.4f}%s\n",
+                         result.Items, result.Iterations, result.NsPerItem, result.NsPerItemMin,
+                         i + 1 < results_.size() ? "," : "");
+        }
+        std::fprintf(file, "  ]\n}\n");
+
+        if (file != stdout) std::fclose(file);
+        return true;
+    }
+
+private:
+    BenchOptions options_;
+    std::vector<BenchResult> results_;
+};
+
+// A display of the given resolution with a bottom taskbar, as the headless driver sets it up
+struct Scene {
+    DisplayData Display;
+    Rect TaskbarRect{};
+
+    Scene(const Resolution resolution, const SnowModelType model = SnowModelType::Grid) {
+        constexpr int TASKBAR_HEIGHT = 48;
+        const float scaleFactor = static_cast<float>(resolution.Height) / 1080.0f;
+        static_cast<void>(Display.SetSnowModel(model));
+        static_cast<void>(Display.SetSceneBounds(
+            Rect{0, 0, resolution.Width, resolution.Height - TASKBAR_HEIGHT}, scaleFactor));
+        TaskbarRect = Rect{0, resolution.Height - TASKBAR_HEIGHT, resolution.Width, resolution.Height};
+    }
+};
+
+[[nodiscard]] std::vector<Param> ParticleParams(const size_t count, const Resolution resolution) {
+    return {Number("particles", static_cast<double>(count)), Number("width", resolution.Width),
+            Number("height", resolution.Height)};
+}
+
+void BenchRain(Bench& bench) {
+    if (!bench.Wants("rain.update")) return;
+
+    for (const Resolution resolution : RESOLUTIONS) {
+        for (const size_t count : PARTICLE_COUNTS) {
+            Scene scene(resolution);
+            RainField rain(&scene.Display);
+            const auto refill = [&] {
+                rain.RemoveDead();
+                rain.Spawn(static_cast<int>(count - rain.GetFallingCount()), 3);
+            };
+
+            // Drops, their splatters and the splatters of earlier hits, in one Update
+            bench.Measure("rain.update", ParticleParams(count, resolution), [&] { return rain.Size(); }, refill,
+                          [&] { rain.Update(STEP_SECONDS); });
+        }
+    }
+}
+
+void BenchSplatters(Bench& bench) {
+    if (!bench.Wants("splatter.update")) return;
+
+    for (const size_t count : PARTICLE_COUNTS) {
+        Scene scene(RESOLUTIONS[0]);
+        SplatterPool splatters(&scene.Display);
+        splatters.Reserve(count);
+        auto& rng = RandomGenerator::GetInstance();
+        const auto refill = [&] {
+            while (splatters.ActiveCount() < count) {
+                const Vector2 pos(rng.GenerateFloat(0.0f, 1920.0f), rng.GenerateFloat(900.0f, 1032.0f));
+                const float angle = static_cast<float>(rng.GenerateInt(20, 70, 110, 160)) * (3.14159265f / 180.0f);
+                splatters.Emit(pos, Vector2(60.0f * std::cos(angle), -60.0f * std::sin(angle)));
+            }
+        };
+
+        bench.Measure("splatter.update", ParticleParams(count, RESOLUTIONS[0]),
+                      [&] { return splatters.ActiveCount(); }, refill, [&] { splatters.Update(STEP_SECONDS); });
+    }
+}
+
+void BenchSnow(Bench& bench) {
+    for (const Resolution resolution : RESOLUTIONS) {
+        for (const size_t count : PARTICLE_COUNTS) {
+            if (bench.Wants("snow.update")) {
+                Scene scene(resolution);
+                SnowField snow(&scene.Display);
+                snow.Spawn(static_cast<int>(count));
+
+                // Includes the flow field advance and the settle and respawn passes. Landed
+                // flakes are cleared before each step, so snow never piles up across iterations
+                bench.Measure("snow.update", ParticleParams(count, resolution), [&] { return snow.Size(); },
+                              [&] { scene.Display.ReleaseSettledSnow(); }, [&] { snow.Update(STEP_SECONDS); });
+            }
+
+            if (bench.Wants("snow.apply_wind")) {
+                Scene scene(resolution);
+                SnowField snow(&scene.Display);
+                snow.Spawn(static_cast<int>(count));
+                float wind = 3.0f;
+
+                // Alternate directions so the velocities stay in range
+                bench.Measure("snow.apply_wind", ParticleParams(count, resolution), [&] { return snow.Size(); },
+                              [&] { wind = -wind; }, [&] { snow.ApplyWind(wind, STEP_SECONDS); });
+            }
+        }
+    }
+}
+
+// Synthetic settled snow: returns the topmost row painted
+using DriftShape = int (*)(SettledSnow& snow);
+
+int PaintDrifts(SettledSnow& snow) {
+    // Sine dunes, steep enough in places to slide
+    const int width = snow.GetWidth();
+    const int height = snow.GetHeight();
+    int top = height;
+    for (int x = 0; x < width; ++x) {
+        const double phase = static_cast<double>(x) / width * 6.283185307179586;
+        const int depth = static_cast<int>(height * (0.08 + 0.06 * std::sin(phase * 5.0) + 0.03 * std::sin(phase * 23.0)));
+        for (int y = height - 1; y >= height - depth; --y) {
+            snow.SetSnow(x, y);
+        }
+        top = std::min(top, height - depth);
+    }
+    return top;
+}
+
+int PaintPiles(SettledSnow& snow) {
+    // Narrow towers that collapse towards the angle of repose
+    const int width = snow.GetWidth();
+    const int height = snow.GetHeight();
+    const int towerHeight = height / 3;
+    for (int x = 0; x < width; ++x) {
+        const bool tower = (x / 24) % 8 == 0;
+        const int depth = tower ? towerHeight : height / 50;
+        for (int y = height - 1; y >= height - depth; --y) {
+            snow.SetSnow(x, y);
+        }
+    }
+    return height - towerHeight;
+}
+
+int PaintFlurry(SettledSnow& snow) {
+    // Loose cells scattered through the lower half, still falling into place
+    const int width = snow.GetWidth();
+    const int height = snow.GetHeight();
+    auto& rng = RandomGenerator::GetInstance();
+    const int cells = width * height / 40;
+    for (int i = 0; i < cells; ++i) {
+        snow.SetSnow(rng.GenerateInt(0, width - 1), rng.GenerateInt(height / 2, height - 1));
+    }
+    return height / 2;
+}
+
+void BenchSettle(Bench& bench) {
+    if (!bench.Wants("snow.settle")) return;
+
+    constexpr int PASSES_PER_SHAPE = 64; // Passes before the shape is painted again
+    const struct {
+        const char* Name;
+        DriftShape Paint;
+    } shapes[] = {{"drifts", PaintDrifts}, {"piles", PaintPiles}, {"flurry", PaintFlurry}};
+
+    for (const SnowModelType model : {SnowModelType::Grid, SnowModelType::Heightmap}) {
+        for (const Resolution resolution : RESOLUTIONS) {
+            for (const auto& shape : shapes) {
+                Scene scene(resolution, model);
+                SettledSnow& snow = *scene.Display.GetSettledSnow();
+                int topRow = 0;
+                int passes = PASSES_PER_SHAPE;
+                const auto repaint = [&] {
+                    if (passes++ < PASSES_PER_SHAPE) return;
+                    snow.Clear();
+                    topRow = std::max(shape.Paint(snow) - 1, 0);
+                    passes = 1;
+                };
+
+                std::vector<Param> params = {
+                    Text("model", model == SnowModelType::Grid ? "grid" : "heightmap"), Text("shape", shape.Name),
+                    Number("width", resolution.Width), Number("height", resolution.Height),
+                    Number("cells_wide", snow.GetWidth()), Number("cells_high", snow.GetHeight())};
+
+                // Items are the cells from topRow down, or the columns of a heightmap
+                const auto items = [&] {
+                    const auto width = static_cast<size_t>(snow.GetWidth());
+                    return model == SnowModelType::Heightmap
+                               ? width
+                               : width * static_cast<size_t>(snow.GetHeight() - topRow);
+                };
+                bench.Measure("snow.settle", std::move(params), items, repaint,
+                              [&] { snow.Settle(topRow, SnowFlake::GetSnowAccumulationChance()); });
+            }
+        }
+    }
+}
+
+void BenchMath(Bench& bench) {
+    constexpr size_t SEGMENTS = 4096;
+    const Rect sceneRect{0, 0, 1920, 1032};
+    auto& rng = RandomGenerator::GetInstance();
+
+    // Rain trails: mostly inside the scene, some crossing an edge
+    std::vector<PointF> starts(SEGMENTS);
+    std::vector<PointF> ends(SEGMENTS);
+    std::vector<Vector2> positions(SEGMENTS);
+    std::vector<Vector2> velocities(SEGMENTS);
+    std::vector<float> lengths(SEGMENTS);
+    for (size_t i = 0; i < SEGMENTS; ++i) {
+        const Vector2 end(rng.GenerateFloat(-100.0f, 2020.0f), rng.GenerateFloat(-100.0f, 1132.0f));
+        const Vector2 vel(rng.GenerateFloat(-300.0f, 300.0f), rng.GenerateFloat(600.0f, 900.0f));
+        lengths[i] = rng.GenerateFloat(30.0f, 100.0f);
+        const Vector2 start = MathUtil::FindFirstPoint(lengths[i], end, vel);
+        starts[i] = start.ToPoint();
+        ends[i] = end.ToPoint();
+        positions[i] = end;
+        velocities[i] = vel;
+    }
+
+    std::vector<Param> params = {Number("segments", static_cast<double>(SEGMENTS))};
+    if (bench.Wants("math.trim_line_segment")) {
+        std::vector<PointF> trimmed(SEGMENTS * 2);
+        bench.Measure("math.trim_line_segment", params, [] { return SEGMENTS; }, [] {}, [&] {
+            for (size_t i = 0; i < SEGMENTS; ++i) {
+                MathUtil::TrimLineSegment(sceneRect, starts[i], ends[i], trimmed[i * 2], trimmed[i * 2 + 1]);
+            }
+        });
+    }
+
+    if (bench.Wants("math.find_first_point")) {
+        std::vector<Vector2> firstPoints(SEGMENTS);
+        bench.Measure("math.find_first_point", params, [] { return SEGMENTS; }, [] {}, [&] {
+            for (size_t i = 0; i < SEGMENTS; ++i) {
+                firstPoints[i] = MathUtil::FindFirstPoint(lengths[i], positions[i], velocities[i]);
+            }
+        });
+    }
+}
+
+void BenchPuddles(Bench& bench) {
+    if (!bench.Wants("puddle.create_or_add")) return;
+
+    constexpr size_t HITS = 1024;
+    for (const Resolution resolution : RESOLUTIONS) {
+        Scene scene(resolution);
+        PuddleManager puddles(&scene.Display);
+        puddles.SetTaskbarRect(scene.TaskbarRect);
+
+        // Ground hits spread along the taskbar; the manager caps the puddle count
+        auto& rng = RandomGenerator::GetInstance();
+        std::vector<Vector2> hits(HITS);
+        for (Vector2& hit : hits) {
+            hit = Vector2(rng.GenerateFloat(0.0f, static_cast<float>(resolution.Width)),
+                          static_cast<float>(scene.TaskbarRect.top));
+        }
+
+        bench.Measure("puddle.create_or_add",
+                      {Number("hits", HITS), Number("width", resolution.Width), Number("height", resolution.Height)},
+                      [] { return HITS; }, [&] { puddles.Reset(); }, [&] {
+                          for (const Vector2& hit : hits) {
+                              puddles.CreateOrAddToPuddle(hit);
+                          }
+                      });
+    }
+}
+
+void BenchNoise(Bench& bench) {
+    FastNoiseLite noise;
+    noise.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
+
+    for (const size_t count : PARTICLE_COUNTS) {
+        // A row of flow field samples, as SnowField takes them
+        std::vector<float> xs(count);
+        std::vector<float> ys(count);
+        std::vector<float> zs(count);
+        std::vector<float> out(count);
+        for (size_t i = 0; i < count; ++i) {
+            xs[i] = static_cast<float>(i % 256) * 32.0f * 0.005f;
+            ys[i] = static_cast<float>(i / 256) * 32.0f * 0.005f;
+            zs[i] = 12.5f;
+        }
+        const std::vector<Param> params = {Number("samples", static_cast<double>(count))};
+
+        if (bench.Wants("noise.get_noise_2d")) {
+            bench.Measure("noise.get_noise_2d", params, [count] { return count; }, [] {}, [&] {
+                for (size_t i = 0; i < count; ++i) {
+                    out[i] = noise.GetNoise(xs[i], ys[i]);
+                }
+            });
+        }
+        if (bench.Wants("noise.get_noise_3d")) {
+            bench.Measure("noise.get_noise_3d", params, [count] { return count; }, [] {}, [&] {
+                for (size_t i = 0; i < count; ++i) {
+                    out[i] = noise.GetNoise(xs[i], ys[i], zs[i]);
+                }
+            });
+        }
+        if (bench.Wants("noise.batch_3d")) {
+            bench.Measure("noise.batch_3d", params, [count] { return count; }, [] {},
+                          [&] { noise.GetNoiseBatch(xs.data(), ys.data(), zs.data(), out.data(), count); });
+        }
+    }
+}
+
+void PrintUsage(const char* exe) {
+    std::printf(
+        "Usage: %s [options]\n"
+        "  --filter <text>     Only run cases whose name contains text, e.g. snow. or rain.update\n"
+        "  --min-time <ms>     Timed milliseconds per case, over 5 rounds (default 100)\n"
+        "  --json <file>       Also write the results as JSON; - writes only JSON to stdout\n"
+        "  --label <text>      Label stored in the JSON, e.g. the commit being measured\n"
+        "Cases: rain.update, splatter.update, snow.update, snow.apply_wind, snow.settle,\n"
+        "       math.trim_line_segment, math.find_first_point, puddle.create_or_add,\n"
+        "       noise.get_noise_2d, noise.get_noise_3d, noise.batch_3d\n",
+        exe);
+}
+
+[[nodiscard]] bool ParseOptions(const int argc, char** argv, BenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        }
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "Missing value for %s\n", argv[i]);
+            return false;
+        }
+        const char* value = argv[++i];
+
+        if (arg == "--filter") {
+            options.Filter = value;
+        } else if (arg == "--min-time") {
+            options.MinTimeMs = std::atof(value);
+        } else if (arg == "--json") {
+            options.JsonPath = value;
+        } else if (arg == "--label") {
+            options.Label = value;
+        } else {
+            std::fprintf(stderr, "Unknown option %s\n", argv[i - 1]);
+            return false;
+        }
+    }
+
+    if (options.MinTimeMs <= 0.0) {
+        std::fprintf(stderr, "Invalid --min-time\n");
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    // The same particles and shapes on every run
+    RandomGenerator::GetInstance().Seed(BENCH_SEED);
+
+    Bench bench(options);
+    BenchRain(bench);
+    BenchSplatters(bench);
+    BenchSnow(bench);
+    BenchSettle(bench);
+    BenchMath(bench);
+    BenchPuddles(bench);
+    BenchNoise(bench);
+    return bench.WriteJson() ? 0 : 1;
+}
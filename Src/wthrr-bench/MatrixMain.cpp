@@ -0,0 +1,484 @@
+// Scaling matrix for whole frames of the wthrr simulation.
+//
+// Runs the full per-display frame of DisplayWindow::Animate (the fixed
+// steps, then everything the draw path computes, handed to a DrawRecorder
+// instead of Direct2D) for every combination of monitor count, resolution,
+// weather, MaxParticles and snow wind, and writes the frame time
+// distribution and peak memory of each combination as one CSV row.
+//
+// Each combination runs in a forked child from the same seed, so its peak
+// resident memory is its own and no run inherits another's caches or heap.
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "DisplayData.h"
+#include "DrawRecorder.h"
+#include "RandomGenerator.h"
+#include "Settings.h"
+#include "SimulationClock.h"
+#include "SnowFlake.h"
+#include "WeatherSimulation.h"
+#include "WorkerPool.h"
+
+using namespace RainEngine;
+
+namespace {
+
+struct Resolution {
+    int Width;
+    int Height;
+};
+
+struct MatrixOptions {
+    std::vector<int> Monitors{1, 2, 3, 4};
+    std::vector<Resolution> Resolutions{{1920, 1080}, {2560, 1440}, {3840, 2160}, {7680, 4320}};
+    std::vector<ParticleType> Weathers{ParticleType::Rain, ParticleType::Snow};
+    std::vector<int> Particles{1, 10, 25, 50, 75};
+    std::vector<int> SnowWinds{0, 50}; // 0 is off; rain ignores this axis
+    int Frames = 600;
+    int Warmup = 120;
+    double FrameTime = 1.0 / 60.0;
+    int TaskbarHeight = 48;
+    std::uint64_t Seed = 1;
+    int SettleThreads = -1; // -1 keeps the default pool
+    std::string CsvPath;
+    Setting Settings{};
+};
+
+// One cell of the matrix
+struct Config {
+    int Monitors = 1;
+    Resolution Size{};
+    ParticleType Weather = ParticleType::Rain;
+    int MaxParticles = 10;
+    int SnowWind = 0;
+};
+
+// One monitor: what DisplayWindow owns besides its window and device
+struct Display {
+    DisplayData Data;
+    std::unique_ptr<WeatherSimulation> Simulation;
+    DrawRecorder Recorder;
+};
+
+const char* CSV_HEADER =
+    "monitors,width,height,weather,max_particles,snow_wind,frames,steps,mean_ms,p50_ms,p99_ms,max_ms,"
+    "draw_commands,particles,peak_rss_kb,snow_kb\n";
+
+void PrintUsage(const char* exe) {
+    std::printf(
+        "Usage: %s [options]\n"
+        "Axes, as comma separated lists:\n"
+        "  --monitors <list>       Monitor counts (default 1,2,3,4)\n"
+        "  --resolutions <list>    1080p, 1440p, 4k, 5k, 8k or WxH (default 1080p,1440p,4k,8k)\n"
+        "  --weather <list>        rain and/or snow (default rain,snow)\n"
+        "  --particles <list>      MaxParticles values, 1-75 (default 1,10,25,50,75)\n"
+        "  --snow-wind <list>      Snow wind intensities, 0 for off (default 0,50)\n"
+        "Run:\n"
+        "  --frames <n>            Measured frames per configuration (default 600)\n"
+        "  --warmup <n>            Frames run first and not measured (default 120)\n"
+        "  --fps <n>               Simulated frame rate (default 60)\n"
+        "  --taskbar <px>          Taskbar height at the bottom, 0 for none (default 48)\n"
+        "  --snow-render <mode>    Settled snow drawing: shapes or bitmap (default shapes)\n"
+        "  --snow-model <model>    Settled snow model: grid or heightmap (default grid)\n"
+        "  --settle-threads <n>    Worker threads for settling snow besides the main one\n"
+        "  --seed <n>              Seed of every configuration (default 1)\n"
+        "  --csv <file>            Write the CSV to a file instead of stdout\n",
+        exe);
+}
+
+[[nodiscard]] bool ParseInts(const char* value, std::vector<int>& out) {
+    out.clear();
+    for (const char* p = value; *p;) {
+        char* end = nullptr;
+        const long number = std::strtol(p, &end, 10);
+        if (end == p) return false;
+        out.push_back(static_cast<int>(number));
+        p = *end == ',' ? end + 1 : end;
+        if (*end && *end != ',') return false;
+    }
+    return !out.empty();
+}
+
+[[nodiscard]] bool ParseResolutions(const char* value, std::vector<Resolution>& out) {
+    out.clear();
+    std::string_view rest = value;
+    while (!rest.empty()) {
+        const size_t comma = rest.find(',');
+        const std::string item(rest.substr(0, comma));
+        rest = comma == std::string_view::npos ? std::string_view{} : rest.substr(comma + 1);
+
+        if (item == "1080p") {
+            out.push_back({1920, 1080});
+        } else if (item == "1440p") {
+            out.push_back({2560, 1440});
+        } else if (item == "4k" || item == "4K") {
+            out.push_back({3840, 2160});
+        } else if (item == "5k" || item == "5K") {
+            out.push_back({5120, 2880});
+        } else if (item == "8k" || item == "8K") {
+            out.push_back({7680, 4320});
+        } else {
+            Resolution resolution{};
+            if (std::sscanf(item.c_str(), "%dx%d", &resolution.Width, &resolution.Height) != 2 ||
+                resolution.Width <= 0 || resolution.Height <= 0) {
+                return false;
+            }
+            out.push_back(resolution);
+        }
+    }
+    return !out.empty();
+}
+
+[[nodiscard]] bool ParseWeathers(const char* value, std::vector<ParticleType>& out) {
+    out.clear();
+    std::string_view rest = value;
+    while (!rest.empty()) {
+        const size_t comma = rest.find(',');
+        const std::string_view item = rest.substr(0, comma);
+        rest = comma == std::string_view::npos ? std::string_view{} : rest.substr(comma + 1);
+
+        if (item == "rain") {
+            out.push_back(ParticleType::Rain);
+        } else if (item == "snow") {
+            out.push_back(ParticleType::Snow);
+        } else {
+            return false;
+        }
+    }
+    return !out.empty();
+}
+
+[[nodiscard]] bool ParseOptions(int argc, char** argv, MatrixOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        }
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "Missing value for %s\n", argv[i]);
+            return false;
+        }
+        const char* value = argv[++i];
+
+        bool valid = true;
+        if (arg == "--monitors") {
+            valid = ParseInts(value, options.Monitors);
+        } else if (arg == "--resolutions") {
+            valid = ParseResolutions(value, options.Resolutions);
+        } else if (arg == "--weather") {
+            valid = ParseWeathers(value, options.Weathers);
+        } else if (arg == "--particles") {
+            valid = ParseInts(value, options.Particles);
+        } else if (arg == "--snow-wind") {
+            valid = ParseInts(value, options.SnowWinds);
+        } else if (arg == "--frames") {
+            options.Frames = std::atoi(value);
+        } else if (arg == "--warmup") {
+            options.Warmup = std::atoi(value);
+        } else if (arg == "--fps") {
+            options.FrameTime = 1.0 / std::atof(value);
+        } else if (arg == "--taskbar") {
+            options.TaskbarHeight = std::atoi(value);
+        } else if (arg == "--snow-render") {
+            options.Settings.SnowRender =
+                std::strcmp(value, "bitmap") == 0 ? SnowRenderMode::Bitmap : SnowRenderMode::Shapes;
+        } else if (arg == "--snow-model") {
+            options.Settings.SnowModel =
+                std::strcmp(value, "heightmap") == 0 ? SnowModelType::Heightmap : SnowModelType::Grid;
+        } else if (arg == "--settle-threads") {
+            options.SettleThreads = std::max(std::atoi(value), 0);
+        } else if (arg == "--seed") {
+            options.Seed = std::strtoull(value, nullptr, 0);
+        } else if (arg == "--csv") {
+            options.CsvPath = value;
+        } else {
+            std::fprintf(stderr, "Unknown option %s\n", argv[i - 1]);
+            return false;
+        }
+
+        if (!valid) {
+            std::fprintf(stderr, "Invalid list for %s: %s\n", argv[i - 1], value);
+            return false;
+        }
+    }
+
+    const auto badMonitors = [](const int n) { return n < 1; };
+    const auto badParticles = [](const int n) { return n < 1 || n > 75; };
+    const auto badWind = [](const int n) { return n < 0 || n > 100; };
+    const auto badHeight = [&options](const Resolution r) { return r.Height <= options.TaskbarHeight; };
+    if (std::any_of(options.Monitors.begin(), options.Monitors.end(), badMonitors) ||
+        std::any_of(options.Particles.begin(), options.Particles.end(), badParticles) ||
+        std::any_of(options.SnowWinds.begin(), options.SnowWinds.end(), badWind) ||
+        std::any_of(options.Resolutions.begin(), options.Resolutions.end(), badHeight) ||
+        options.TaskbarHeight < 0 || options.Frames <= 0 || options.Warmup < 0 || options.FrameTime <= 0.0) {
+        std::fprintf(stderr, "Invalid matrix or frame settings\n");
+        return false;
+    }
+    return true;
+}
+
+[[nodiscard]] std::vector<Config> BuildMatrix(const MatrixOptions& options) {
+    std::vector<Config> configs;
+    for (const int monitors : options.Monitors) {
+        for (const Resolution size : options.Resolutions) {
+            for (const ParticleType weather : options.Weathers) {
+                for (const int particles : options.Particles) {
+                    if (weather == ParticleType::Rain) {
+                        configs.push_back({monitors, size, weather, particles, 0});
+                        continue;
+                    }
+                    for (const int wind : options.SnowWinds) {
+                        configs.push_back({monitors, size, weather, particles, wind});
+                    }
+                }
+            }
+        }
+    }
+    return configs;
+}
+
+// Peak resident set of this process, from /proc
+[[nodiscard]] long PeakResidentKb() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("VmHWM:", 0) == 0) {
+            return std::atol(line.c_str() + 6);
+        }
+    }
+    return -1;
+}
+
+// What DisplayWindow::Animate does for one display, drawing into the recorder
+void AnimateDisplay(Display& display, const SimulationClock& clock, const Setting& settings) {
+    display.Simulation->Advance(clock);
+
+    DrawRecorder& recorder = display.Recorder;
+    recorder.Clear();
+    if (settings.PartType == ParticleType::Rain) {
+        if (const float flash = display.Simulation->GetLightningFlashIntensity(); flash > 0.0f) {
+            recorder.FillRect(display.Data.SceneRect, flash);
+        }
+        display.Simulation->GetRainField().Record(recorder);
+        display.Simulation->GetPuddleManager()->Record(recorder);
+        return;
+    }
+
+    display.Simulation->GetSnowField().Record(recorder);
+    if (!display.Simulation->GetSnowField().IsEmpty()) {
+        if (settings.SnowRender == SnowRenderMode::Bitmap) {
+            SnowFlake::RecordSettledSnowLayer(recorder, &display.Data);
+        } else {
+            SnowFlake::RecordSettledSnow2(recorder, &display.Data);
+        }
+    }
+}
+
+// Run one configuration and format its CSV row, or an empty string on failure
+[[nodiscard]] std::string RunConfig(const Config& config, const MatrixOptions& options) {
+    if (options.SettleThreads >= 0) {
+        WorkerPool::SetSharedWorkerThreads(static_cast<size_t>(options.SettleThreads));
+    }
+    RandomGenerator::GetInstance().Seed(options.Seed);
+
+    Setting settings = options.Settings;
+    settings.PartType = config.Weather;
+    settings.MaxParticles = config.MaxParticles;
+    settings.EnableSnowWind = config.SnowWind > 0;
+    settings.SnowWindIntensity = config.SnowWind;
+
+    // Same scene layout DisplayWindow::FindSceneRect produces for a bottom taskbar
+    const Resolution size = config.Size;
+    const Rect sceneRect{0, 0, size.Width, size.Height - options.TaskbarHeight};
+    const float scaleFactor = static_cast<float>(size.Height) / 1080.0f;
+
+    std::vector<std::unique_ptr<Display>> displays;
+    for (int i = 0; i < config.Monitors; ++i) {
+        auto display = std::make_unique<Display>();
+        static_cast<void>(display->Data.SetSnowModel(settings.SnowModel));
+        if (const auto result = display->Data.SetSceneBounds(sceneRect, scaleFactor); result.IsError()) {
+            std::fprintf(stderr, "SetSceneBounds failed: %s\n", result.GetMessage().c_str());
+            return {};
+        }
+        static_cast<void>(display->Data.SetRainColor(settings.ParticleColor));
+
+        display->Simulation = std::make_unique<WeatherSimulation>(&display->Data, &settings);
+        if (options.TaskbarHeight > 0) {
+            display->Simulation->GetPuddleManager()->SetTaskbarRect(
+                Rect{0, size.Height - options.TaskbarHeight, size.Width, size.Height});
+        }
+        displays.push_back(std::move(display));
+    }
+
+    // Frames are a fixed FrameTime apart, as in the headless driver; only the
+    // wall time each frame takes is measured
+    using Clock = std::chrono::steady_clock;
+    SimulationClock clock;
+    std::vector<double> frameMs;
+    frameMs.reserve(static_cast<size_t>(options.Frames));
+    long long steps = 0;
+    double commands = 0.0;
+    for (int frame = 0; frame < options.Warmup + options.Frames; ++frame) {
+        const auto start = Clock::now();
+        clock.BeginFrame(options.FrameTime);
+        for (const auto& display : displays) {
+            AnimateDisplay(*display, clock, settings);
+        }
+        const double elapsed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        if (frame >= options.Warmup) {
+            frameMs.push_back(elapsed);
+            steps += clock.GetFrameSteps();
+            for (const auto& display : displays) {
+                commands += static_cast<double>(display->Recorder.Size());
+            }
+        }
+    }
+
+    double particles = 0.0;
+    size_t snowBytes = 0;
+    for (const auto& display : displays) {
+        const WeatherSimulation& simulation = *display->Simulation;
+        particles += static_cast<double>(simulation.GetRainField().GetLiveCount() +
+                                         simulation.GetRainField().GetSplatters().ActiveCount() +
+                                         simulation.GetSnowField().Size());
+        snowBytes += display->Data.GetSettledSnow()->GetMemoryUsage();
+    }
+
+    double totalMs = 0.0;
+    for (const double ms : frameMs) {
+        totalMs += ms;
+    }
+    std::sort(frameMs.begin(), frameMs.end());
+    const size_t count = frameMs.size();
+    const auto nearestRank = [&](const double percentile) {
+        const auto rank = static_cast<size_t>(std::ceil(percentile * static_cast<double>(count)));
+        return frameMs[std::clamp<size_t>(rank, 1, count) - 1];
+    };
+
+    char row[512];
+    std::snprintf(row, sizeof row, "%d,%d,%d,%s,%d,%d,%d,%lld,%.4f,%.4f,%.4f,%.4f,%.1f,%.0f,%ld,%.1f\n",
+                  config.Monitors, size.Width, size.Height,
+                  config.Weather == ParticleType::Snow ? "snow" : "rain", config.MaxParticles, config.SnowWind,
+                  options.Frames, steps, totalMs / static_cast<double>(count), nearestRank(0.50),
+                  nearestRank(0.99), frameMs.back(), commands / static_cast<double>(count), particles,
+                  PeakResidentKb(), static_cast<double>(snowBytes) / 1024.0);
+    return row;
+}
+
+// RunConfig in a child process; returns its row, or an empty string if it failed
+[[nodiscard]] std::string RunIsolated(const Config& config, const MatrixOptions& options) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        std::perror("pipe");
+        return {};
+    }
+    std::fflush(nullptr);
+
+    const pid_t pid = fork();
+    if (pid < 0) {
+        std::perror("fork");
+        close(fds[0]);
+        close(fds[1]);
+        return {};
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        const std::string row = RunConfig(config, options);
+        size_t written = 0;
+        while (written < row.size()) {
+            const ssize_t n = write(fds[1], row.data() + written, row.size() - written);
+            if (n <= 0) break;
+            written += static_cast<size_t>(n);
+        }
+        close(fds[1]);
+        std::fflush(nullptr);
+        _exit(row.empty() || written < row.size() ? 1 : 0);
+    }
+
+    close(fds[1]);
+    std::string row;
+    char buffer[512];
+    for (ssize_t n; (n = read(fds[0], buffer, sizeof buffer)) > 0;) {
+        row.append(buffer, static_cast<size_t>(n));
+    }
+    close(fds[0]);
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        return {};
+    }
+    return row;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    MatrixOptions options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    FILE* csv = options.CsvPath.empty() ? stdout : std::fopen(options.CsvPath.c_str(), "w");
+    if (!csv) {
+        std::fprintf(stderr, "Cannot write %s\n", options.CsvPath.c_str());
+        return 1;
+    }
+    std::fputs(CSV_HEADER, csv);
+    std::fflush(csv);
+
+    // Progress and the worst cell go to stderr, so stdout stays plain CSV
+    const std::vector<Config> configs = BuildMatrix(options);
+    std::string worstRow;
+    double worstP99 = -1.0;
+    int failures = 0;
+    for (size_t i = 0; i < configs.size(); ++i) {
+        const Config& config = configs[i];
+        std::fprintf(stderr, "[%zu/%zu] %d x %dx%d %s MaxParticles %d snow wind %d\n", i + 1, configs.size(),
+                     config.Monitors, config.Size.Width, config.Size.Height,
+                     config.Weather == ParticleType::Snow ? "snow" : "rain", config.MaxParticles, config.SnowWind);
+
+        const std::string row = RunIsolated(config, options);
+        if (row.empty()) {
+            std::fprintf(stderr, "  failed\n");
+            ++failures;
+            continue;
+        }
+        std::fputs(row.c_str(), csv);
+        std::fflush(csv);
+
+        // p99_ms is the eleventh column
+        const char* field = row.c_str();
+        for (int column = 0; column < 10 && field; ++column) {
+            field = std::strchr(field, ',');
+            if (field) ++field;
+        }
+        if (field && std::atof(field) > worstP99) {
+            worstP99 = std::atof(field);
+            worstRow = row;
+        }
+    }
+
+    if (csv != stdout) std::fclose(csv);
+    if (!worstRow.empty()) {
+        std::fprintf(stderr, "worst p99 frame: %s%s", CSV_HEADER, worstRow.c_str());
+    }
+    return failures == 0 ? 0 : 1;
+}
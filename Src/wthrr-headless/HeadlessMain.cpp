@@ -0,0 +1,367 @@
+// Headless driver for the wthrr simulation core.
+//
+// Steps the same per-display update that DisplayWindow::Animate runs, at a
+// chosen resolution and without any window, swap chain or Direct2D device.
+// Intended for profilers, sanitizers and benchmarking on non-Windows hosts.
+//
+// A run is fixed by its seed, options and timeline: the same three replay
+// it bit for bit, which the state digest printed at the end confirms.
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "CounterRandom.h"
+#include "DisplayData.h"
+#include "RandomGenerator.h"
+#include "Settings.h"
+#include "SimulationClock.h"
+#include "WeatherSimulation.h"
+#include "WorkerPool.h"
+
+using namespace RainEngine;
+
+namespace {
+
+struct HeadlessOptions {
+    int Width = 1920;
+    int Height = 1080;
+    int TaskbarHeight = 48;
+    int Frames = 600;
+    double FrameTime = 1.0 / 60.0;
+    float SpawnRate = 0.0f;
+    bool RenderSnow = false; // Run the CPU side of the settled snow renderer every frame
+    double TimeScale = 1.0;
+    bool Paused = false;
+    double FastForward = 0.0; // Seconds still to hand to the clock
+    bool HasSeed = false;
+    std::uint64_t Seed = 0;
+    std::string TimelinePath;
+    Setting Settings{};
+};
+
+// A setting change applied before the given frame
+struct TimelineEvent {
+    int Frame = 0;
+    std::string Option;
+    std::string Value;
+};
+
+void PrintUsage(const char* exe) {
+    std::printf(
+        "Usage: %s [options]\n"
+        "  --width <px>            Monitor width (default 1920)\n"
+        "  --height <px>           Monitor height (default 1080)\n"
+        "  --taskbar <px>          Taskbar height at the bottom, 0 for none (default 48)\n"
+        "  --weather <rain|snow>   Particle type (default rain)\n"
+        "  --particles <1-75>      MaxParticles setting (default 10)\n"
+        "  --wind <n>              Rain wind direction factor (default 3)\n"
+        "  --snow-wind <0-100>     Enable snow wind with the given intensity\n"
+        "  --spawn-rate <n>        Emit particles per second instead of refilling to the cap\n"
+        "  --snow-render <mode>    Also prepare settled snow for drawing: shapes or bitmap\n"
+        "  --snow-model <model>    Settled snow model: grid or heightmap (default grid)\n"
+        "  --snow-cell <px>        Pixels per settled snow cell, 0 follows the scale (default 0)\n"
+        "  --settle-threads <n>    Worker threads for settling snow besides the main one\n"
+        "  --frames <n>            Number of frames to simulate (default 600)\n"
+        "  --fps <n>               Simulated frame rate (default 60)\n"
+        "  --seed <n>              Seed every random draw; the seed of each run is printed\n"
+        "  --time-scale <x>        Simulation seconds per wall second (default 1)\n"
+        "  --pause <0|1>           Stop banking frame time; fast-forward still runs\n"
+        "  --fast-forward <s>      Run s seconds of simulation in extra steps per frame\n"
+        "  --timeline <file>       Apply setting changes during the run, one per line as\n"
+        "                          <frame> <option> <value>, for --weather, --particles,\n"
+        "                          --wind, --snow-wind, --spawn-rate and the clock options\n",
+        exe);
+}
+
+// The options that may also change during a run. Returns false for any other option.
+[[nodiscard]] bool ApplySetting(const std::string_view arg, const char* value, HeadlessOptions& options) {
+    if (arg == "--weather") {
+        options.Settings.PartType = std::strcmp(value, "snow") == 0 ? ParticleType::Snow : ParticleType::Rain;
+    } else if (arg == "--particles") {
+        options.Settings.MaxParticles = std::atoi(value);
+    } else if (arg == "--wind") {
+        options.Settings.WindSpeed = std::atoi(value);
+    } else if (arg == "--snow-wind") {
+        options.Settings.EnableSnowWind = true;
+        options.Settings.SnowWindIntensity = std::atoi(value);
+    } else if (arg == "--spawn-rate") {
+        options.SpawnRate = static_cast<float>(std::atof(value));
+    } else if (arg == "--time-scale") {
+        options.TimeScale = std::atof(value);
+    } else if (arg == "--pause") {
+        options.Paused = std::atoi(value) != 0;
+    } else if (arg == "--fast-forward") {
+        options.FastForward += std::atof(value);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Hand the clock options to the clock; fast-forward time is handed over once
+void ApplyClockOptions(HeadlessOptions& options, SimulationClock& clock) {
+    clock.SetTimeScale(options.TimeScale);
+    clock.SetPaused(options.Paused);
+    clock.FastForward(options.FastForward);
+    options.FastForward = 0.0;
+}
+
+[[nodiscard]] bool ParseOptions(int argc, char** argv, HeadlessOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        }
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "Missing value for %s\n", argv[i]);
+            return false;
+        }
+        const char* value = argv[++i];
+
+        if (ApplySetting(arg, value, options)) {
+            continue;
+        }
+
+        if (arg == "--width") {
+            options.Width = std::atoi(value);
+        } else if (arg == "--height") {
+            options.Height = std::atoi(value);
+        } else if (arg == "--taskbar") {
+            options.TaskbarHeight = std::atoi(value);
+        } else if (arg == "--snow-render") {
+            options.RenderSnow = true;
+            options.Settings.SnowRender =
+                std::strcmp(value, "bitmap") == 0 ? SnowRenderMode::Bitmap : SnowRenderMode::Shapes;
+        } else if (arg == "--snow-model") {
+            options.Settings.SnowModel =
+                std::strcmp(value, "heightmap") == 0 ? SnowModelType::Heightmap : SnowModelType::Grid;
+        } else if (arg == "--snow-cell") {
+            options.Settings.SnowCellSize = std::atoi(value);
+        } else if (arg == "--settle-threads") {
+            WorkerPool::SetSharedWorkerThreads(static_cast<size_t>(std::max(std::atoi(value), 0)));
+        } else if (arg == "--frames") {
+            options.Frames = std::atoi(value);
+        } else if (arg == "--fps") {
+            options.FrameTime = 1.0 / std::atof(value);
+        } else if (arg == "--seed") {
+            options.HasSeed = true;
+            options.Seed = std::strtoull(value, nullptr, 0);
+        } else if (arg == "--timeline") {
+            options.TimelinePath = value;
+        } else {
+            std::fprintf(stderr, "Unknown option %s\n", argv[i - 1]);
+            return false;
+        }
+    }
+
+    if (options.Width <= 0 || options.Height <= options.TaskbarHeight || options.TaskbarHeight < 0 ||
+        options.Frames < 0 || options.FrameTime <= 0.0) {
+        std::fprintf(stderr, "Invalid dimensions or frame settings\n");
+        return false;
+    }
+    return true;
+}
+
+[[nodiscard]] bool LoadTimeline(const std::string& path, std::vector<TimelineEvent>& events) {
+    std::ifstream file(path);
+    if (!file) {
+        std::fprintf(stderr, "Cannot open timeline %s\n", path.c_str());
+        return false;
+    }
+
+    HeadlessOptions scratch;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        if (line.empty() || line[0] == '#') continue;
+
+        std::istringstream fields(line);
+        TimelineEvent event;
+        if (!(fields >> event.Frame >> event.Option >> event.Value) || event.Frame < 0 ||
+            !ApplySetting(event.Option, event.Value.c_str(), scratch)) {
+            std::fprintf(stderr, "%s:%d: expected <frame> <option> <value>\n", path.c_str(), lineNumber);
+            return false;
+        }
+        events.push_back(std::move(event));
+    }
+
+    std::stable_sort(events.begin(), events.end(),
+                     [](const TimelineEvent& a, const TimelineEvent& b) { return a.Frame < b.Frame; });
+    return true;
+}
+
+// Hash of everything the simulation leaves behind, to compare runs
+[[nodiscard]] std::uint64_t StateDigest(const WeatherSimulation& simulation, const DisplayData& displayData) {
+    std::uint64_t hash = 0;
+    const auto add = [&hash](const std::uint64_t value) {
+        hash = CounterRandom::Mix(hash ^ (value + CounterRandom::GOLDEN_GAMMA));
+    };
+    const auto addPosition = [&add](const Vector2 position) {
+        add((static_cast<std::uint64_t>(std::bit_cast<std::uint32_t>(position.x)) << 32) |
+            std::bit_cast<std::uint32_t>(position.y));
+    };
+
+    const RainField& rain = simulation.GetRainField();
+    add(rain.Size());
+    for (size_t i = 0; i < rain.Size(); ++i) {
+        addPosition(rain.GetPosition(i));
+    }
+    add(rain.GetSplatters().ActiveCount());
+    add(simulation.GetPuddleManager()->GetPuddleCount());
+
+    const SnowField& snow = simulation.GetSnowField();
+    add(snow.Size());
+    for (size_t i = 0; i < snow.Size(); ++i) {
+        addPosition(snow.GetPosition(i));
+    }
+
+    const SettledSnow& settled = *displayData.GetSettledSnow();
+    for (int y = 0; y < settled.GetHeight(); ++y) {
+        std::uint64_t word = 0;
+        for (int x = 0; x < settled.GetWidth(); ++x) {
+            word = (word << 1) | (settled.IsSnow(x, y) ? 1u : 0u);
+            if ((x & 63) == 63) {
+                add(word);
+                word = 0;
+            }
+        }
+        add(word);
+    }
+
+    add(std::bit_cast<std::uint32_t>(simulation.GetLightningFlashIntensity()));
+    add(std::bit_cast<std::uint32_t>(simulation.GetCurrentSnowWindFactor()));
+    return hash;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    HeadlessOptions options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    std::vector<TimelineEvent> timeline;
+    if (!options.TimelinePath.empty() && !LoadTimeline(options.TimelinePath, timeline)) {
+        return 1;
+    }
+
+    // Seed before anything draws; the display's snow seed comes from the generator too
+    RandomGenerator& rng = RandomGenerator::GetInstance();
+    if (options.HasSeed) {
+        rng.Seed(options.Seed);
+    }
+    const std::uint64_t seed = rng.GetSeed();
+
+    // Same scene layout DisplayWindow::FindSceneRect produces for a bottom taskbar
+    const Rect sceneRect{0, 0, options.Width, options.Height - options.TaskbarHeight};
+    const float scaleFactor = static_cast<float>(options.Height) / 1080.0f;
+
+    DisplayData displayData;
+    static_cast<void>(displayData.SetSnowModel(options.Settings.SnowModel));
+    if (const auto result = displayData.SetSnowCellSize(options.Settings.SnowCellSize); result.IsError()) {
+        std::fprintf(stderr, "SetSnowCellSize failed: %s\n", result.GetMessage().c_str());
+        return 1;
+    }
+    if (const auto result = displayData.SetSceneBounds(sceneRect, scaleFactor); result.IsError()) {
+        std::fprintf(stderr, "SetSceneBounds failed: %s\n", result.GetMessage().c_str());
+        return 1;
+    }
+    static_cast<void>(displayData.SetRainColor(options.Settings.ParticleColor));
+
+    WeatherSimulation simulation(&displayData, &options.Settings);
+    simulation.SetSpawnRate(options.Settings.PartType, options.SpawnRate);
+    if (options.TaskbarHeight > 0) {
+        simulation.GetPuddleManager()->SetTaskbarRect(
+            Rect{0, options.Height - options.TaskbarHeight, options.Width, options.Height});
+    }
+
+    // Frames are a fixed FrameTime apart, so the run does not depend on the host's speed
+    SimulationClock clock;
+    ApplyClockOptions(options, clock);
+
+    using Clock = std::chrono::steady_clock;
+    long long steps = 0;
+    double renderMs = 0.0;
+    size_t renderWork = 0; // Rows rebuilt (shapes) or pixels uploaded (bitmap)
+    const auto start = Clock::now();
+    size_t nextEvent = 0;
+    for (int frame = 0; frame < options.Frames; ++frame) {
+        if (nextEvent < timeline.size() && timeline[nextEvent].Frame <= frame) {
+            for (; nextEvent < timeline.size() && timeline[nextEvent].Frame <= frame; ++nextEvent) {
+                static_cast<void>(ApplySetting(timeline[nextEvent].Option, timeline[nextEvent].Value.c_str(), options));
+            }
+            simulation.SetSpawnRate(options.Settings.PartType, options.SpawnRate);
+            ApplyClockOptions(options, clock);
+        }
+
+        clock.BeginFrame(options.FrameTime);
+        steps += simulation.Advance(clock);
+
+        // Everything DisplayWindow::DrawSnowFlakes does for settled snow short of the Direct2D calls
+        if (options.RenderSnow && options.Settings.PartType == ParticleType::Snow) {
+            const auto renderStart = Clock::now();
+            const SettledSnow& snow = *displayData.GetSettledSnow();
+            if (options.Settings.SnowRender == SnowRenderMode::Bitmap) {
+                for (const Rect& rect : displayData.GetSnowLayer().Update(snow, displayData.GetRainColor())) {
+                    renderWork += static_cast<size_t>(rect.Width()) * static_cast<size_t>(rect.Height());
+                }
+            } else {
+                renderWork += displayData.GetSnowGeometry().Update(
+                    snow, displayData.MaxSnowHeight, displayData.SceneRect, displayData.ScaleFactor,
+                    displayData.SnowCellSize);
+            }
+            renderMs += std::chrono::duration<double, std::milli>(Clock::now() - renderStart).count();
+        }
+    }
+    const double elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() - renderMs;
+
+    std::printf("resolution      %dx%d (scene %dx%d, scale %.2f)\n",
+                options.Width, options.Height, sceneRect.Width(), sceneRect.Height(), scaleFactor);
+    std::printf("weather         %s, MaxParticles %d\n",
+                options.Settings.PartType == ParticleType::Snow ? "snow" : "rain", options.Settings.MaxParticles);
+    std::printf("frames / steps  %d / %lld, %.2f s simulated\n", options.Frames, steps, clock.Now());
+    std::printf("update time     %.3f ms total, %.4f ms/frame\n",
+                elapsedMs, options.Frames > 0 ? elapsedMs / options.Frames : 0.0);
+    std::printf("rain drops      %zu\n", simulation.GetRainField().Size());
+    std::printf("splatters       %zu live, %zu pooled slots\n",
+                simulation.GetRainField().GetSplatters().ActiveCount(),
+                simulation.GetRainField().GetSplatters().Capacity());
+    std::printf("puddles         %zu\n", simulation.GetPuddleManager()->GetPuddleCount());
+    std::printf("snow flakes     %zu\n", simulation.GetSnowField().Size());
+    std::printf("settled snow    %s, %dx%d cells of %d px, %zu set, max height %d, %zu chunks awake\n",
+                options.Settings.SnowModel == SnowModelType::Heightmap ? "heightmap" : "grid",
+                displayData.GetSettledSnow()->GetWidth(), displayData.GetSettledSnow()->GetHeight(),
+                displayData.SnowCellSize, displayData.GetSettledSnow()->CountSnow(), displayData.MaxSnowHeight,
+                displayData.GetSettledSnow()->CountAwakeChunks());
+    std::printf("snow memory     %.1f KB\n", static_cast<double>(displayData.GetSettledSnow()->GetMemoryUsage()) / 1024.0);
+    std::printf("seed            %llu\n", static_cast<unsigned long long>(seed));
+    std::printf("state digest    %016llx\n",
+                static_cast<unsigned long long>(StateDigest(simulation, displayData)));
+    if (options.RenderSnow && options.Frames > 0) {
+        const bool bitmap = options.Settings.SnowRender == SnowRenderMode::Bitmap;
+        std::printf("snow render     %s, %.4f ms/frame, %.1f %s/frame\n",
+                    bitmap ? "bitmap" : "shapes", renderMs / options.Frames,
+                    static_cast<double>(renderWork) / options.Frames,
+                    bitmap ? "pixels uploaded" : "rows rebuilt");
+        if (bitmap) {
+            std::printf("                %zu dirty rects last frame\n", displayData.GetSnowLayer().GetDirtyRects().size());
+        } else {
+            std::printf("                %zu shapes\n",
+                        displayData.GetSnowGeometry().CountPrimitives(displayData.MaxSnowHeight));
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,168 @@
+// Checks that FastNoiseLite::GetNoiseBatch matches GetNoise bit for bit, on
+// every SIMD level this machine supports and for settings that fall back to
+// the scalar path.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "FastNoiseLite.h"
+#include "FastNoiseLiteBatch.h"
+
+using RainEngine::NoiseBatch::SimdLevel;
+
+namespace {
+
+struct Positions {
+    std::vector<float> X;
+    std::vector<float> Y;
+    std::vector<float> Z;
+};
+
+// Random positions at several scales, plus the lattice points and half steps
+// where the floor and round steps of the noise change
+Positions MakePositions()
+{
+    Positions p;
+    std::mt19937 rng(20240601u);
+    const auto add = [&](const float x, const float y, const float z) {
+        p.X.push_back(x);
+        p.Y.push_back(y);
+        p.Z.push_back(z);
+    };
+
+    for (const float range : {1.0f, 100.0f, 5000.0f, 1.0e6f})
+    {
+        std::uniform_real_distribution<float> dist(-range, range);
+        for (int i = 0; i < 2000; ++i)
+        {
+            add(dist(rng), dist(rng), dist(rng));
+        }
+    }
+    for (int i = -40; i <= 40; ++i)
+    {
+        const float f = static_cast<float>(i) * 50.0f; // Lattice points at frequency 0.01 and 0.02
+        add(f, -f, f * 0.5f);
+        add(f + 25.0f, f - 25.0f, -f);
+    }
+    add(0.0f, 0.0f, 0.0f);
+    add(-0.0f, -0.0f, -0.0f);
+
+    // An odd count, so every kernel leaves a tail for the scalar path
+    if (p.X.size() % 2 == 0)
+    {
+        add(1.5f, -2.5f, 3.5f);
+    }
+    return p;
+}
+
+const char* LevelName(const SimdLevel level)
+{
+    switch (level)
+    {
+    case SimdLevel::Avx2: return "avx2";
+    case SimdLevel::Sse2: return "sse2";
+    default: return "scalar";
+    }
+}
+
+int CompareBits(const char* what, const std::vector<float>& expected, const std::vector<float>& actual)
+{
+    int mismatches = 0;
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        std::uint32_t a = 0;
+        std::uint32_t b = 0;
+        std::memcpy(&a, &expected[i], sizeof a);
+        std::memcpy(&b, &actual[i], sizeof b);
+        if (a != b)
+        {
+            if (mismatches < 5)
+            {
+                std::printf("  %s: position %zu scalar %.9g (0x%08x) batch %.9g (0x%08x)\n", what, i,
+                            expected[i], a, actual[i], b);
+            }
+            ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+int CheckNoise(const FastNoiseLite& noise, const Positions& p, const char* name)
+{
+    const size_t count = p.X.size();
+    std::vector<float> expected(count);
+    std::vector<float> actual(count);
+    int failures = 0;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        expected[i] = noise.GetNoise(p.X[i], p.Y[i]);
+    }
+    noise.GetNoiseBatch(p.X.data(), p.Y.data(), actual.data(), count);
+    const int mismatches2D = CompareBits("2D", expected, actual);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        expected[i] = noise.GetNoise(p.X[i], p.Y[i], p.Z[i]);
+    }
+    noise.GetNoiseBatch(p.X.data(), p.Y.data(), p.Z.data(), actual.data(), count);
+    const int mismatches3D = CompareBits("3D", expected, actual);
+
+    const SimdLevel level = RainEngine::NoiseBatch::GetSimdLevel();
+    std::printf("%-8s %-30s 2D %s, 3D %s\n", LevelName(level), name, mismatches2D ? "FAILED" : "ok",
+                mismatches3D ? "FAILED" : "ok");
+    failures += mismatches2D != 0;
+    failures += mismatches3D != 0;
+    return failures;
+}
+
+} // namespace
+
+int main()
+{
+    const Positions positions = MakePositions();
+    int failures = 0;
+
+    for (const SimdLevel limit : {SimdLevel::Avx2, SimdLevel::Sse2, SimdLevel::Scalar})
+    {
+        RainEngine::NoiseBatch::SetSimdLimit(limit);
+        if (RainEngine::NoiseBatch::GetSimdLevel() != limit)
+        {
+            std::printf("%-8s not supported here, skipped\n", LevelName(limit));
+            continue;
+        }
+
+        FastNoiseLite simplex;
+        simplex.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
+        failures += CheckNoise(simplex, positions, "OpenSimplex2");
+
+        FastNoiseLite seeded(-987654321);
+        seeded.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
+        seeded.SetFrequency(0.02f);
+        failures += CheckNoise(seeded, positions, "OpenSimplex2, seed, frequency");
+
+        FastNoiseLite rotated;
+        rotated.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
+        rotated.SetRotationType3D(FastNoiseLite::RotationType3D_ImproveXYPlanes);
+        failures += CheckNoise(rotated, positions, "OpenSimplex2, XY rotation");
+
+        FastNoiseLite fractal;
+        fractal.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
+        fractal.SetFractalType(FastNoiseLite::FractalType_FBm);
+        failures += CheckNoise(fractal, positions, "OpenSimplex2, FBm");
+
+        FastNoiseLite perlin;
+        perlin.SetNoiseType(FastNoiseLite::NoiseType_Perlin);
+        failures += CheckNoise(perlin, positions, "Perlin");
+    }
+
+    if (failures != 0)
+    {
+        std::printf("%d noise batch checks failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
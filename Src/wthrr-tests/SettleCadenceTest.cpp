@@ -0,0 +1,97 @@
+// Checks that settled snow keeps the same cadence on every display: each
+// WeatherSimulation settles on every other step of the shared clock, however
+// many displays advance from it and however the steps fall into frames.
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "DisplayData.h"
+#include "RandomGenerator.h"
+#include "Settings.h"
+#include "SimulationClock.h"
+#include "WeatherSimulation.h"
+
+using RainEngine::SimulationClock;
+using RainEngine::WeatherSimulation;
+
+namespace {
+
+constexpr int MAX_PARTICLES = 10;
+
+// Odd frame lengths, so frames end on odd and even steps alike
+constexpr double FRAME_SECONDS[] = {1.0 / 60.0, 1.0 / 120.0, 1.0 / 40.0, 1.0 / 90.0};
+constexpr int FRAMES = 200;
+constexpr double FAST_FORWARD_SECONDS = 0.125; // 15 steps
+
+struct Display {
+    DisplayData Data;
+    std::unique_ptr<WeatherSimulation> Simulation;
+};
+
+int CheckDisplays(const int displayCount)
+{
+    RandomGenerator::GetInstance().Seed(11);
+
+    Setting settings;
+    settings.PartType = ParticleType::Snow;
+    settings.MaxParticles = MAX_PARTICLES;
+
+    std::vector<std::unique_ptr<Display>> displays;
+    for (int i = 0; i < displayCount; ++i)
+    {
+        auto display = std::make_unique<Display>();
+        static_cast<void>(display->Data.SetSceneBounds(RainEngine::Rect{0, 0, 640, 360}, 1.0f));
+        display->Simulation = std::make_unique<WeatherSimulation>(&display->Data, &settings);
+        displays.push_back(std::move(display));
+    }
+
+    SimulationClock clock;
+    clock.FastForward(FAST_FORWARD_SECONDS);
+    std::uint64_t steps = 0;
+    for (int frame = 0; frame < FRAMES; ++frame)
+    {
+        clock.BeginFrame(FRAME_SECONDS[frame % 4]);
+        for (const auto& display : displays)
+        {
+            display->Simulation->Advance(clock);
+        }
+        steps += static_cast<std::uint64_t>(clock.GetFrameSteps());
+    }
+
+    int failures = 0;
+    for (int i = 0; i < displayCount; ++i)
+    {
+        const std::uint64_t passes = displays[static_cast<size_t>(i)]->Data.GetSettledSnow()->GetPassCount();
+        if (passes != steps / 2)
+        {
+            std::printf("  %d displays: display %d settled %llu times in %llu steps, expected %llu\n",
+                        displayCount, i, static_cast<unsigned long long>(passes),
+                        static_cast<unsigned long long>(steps), static_cast<unsigned long long>(steps / 2));
+            ++failures;
+        }
+    }
+
+    std::printf("%d display(s), %llu steps: %s\n", displayCount, static_cast<unsigned long long>(steps),
+                failures ? "FAILED" : "ok");
+    return failures;
+}
+
+} // namespace
+
+int main()
+{
+    int failures = 0;
+    for (int displayCount = 1; displayCount <= 3; ++displayCount)
+    {
+        failures += CheckDisplays(displayCount);
+    }
+
+    if (failures != 0)
+    {
+        std::printf("%d settle cadence checks failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
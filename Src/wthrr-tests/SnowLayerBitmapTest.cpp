@@ -0,0 +1,221 @@
+// Checks SnowLayerBitmap without a GPU: the dirty rectangles each Update
+// reports for known changes to settled snow, the pixels it rasterizes, and
+// that Invalidate, a colour change and Release all lead to a full rewrite.
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "CoreTypes.h"
+#include "SettledSnow.h"
+#include "SnowGrid.h"
+#include "SnowHeightmap.h"
+#include "SnowLayerBitmap.h"
+
+using RainEngine::Color;
+using RainEngine::Rect;
+using RainEngine::SettledSnow;
+using RainEngine::SnowGrid;
+using RainEngine::SnowHeightmap;
+using RainEngine::SnowLayerBitmap;
+
+namespace {
+
+// 200 cells wide, so the last word of each row is partly past the width
+constexpr int WIDTH = 200;
+constexpr int HEIGHT = 100;
+
+// Half-transparent orange; premultiplied BGRA 0x80804000
+constexpr Color SNOW_COLOR{1.0f, 0.5f, 0.0f, 0.5f};
+constexpr std::uint32_t SNOW_PIXEL = 0x80804000u;
+
+int failures = 0;
+
+void Check(const bool ok, const char* what)
+{
+    if (!ok)
+    {
+        std::printf("  FAILED: %s\n", what);
+        ++failures;
+    }
+}
+
+bool SameRects(const std::vector<Rect>& actual, const std::vector<Rect>& expected)
+{
+    if (actual.size() != expected.size()) return false;
+    for (size_t i = 0; i < actual.size(); ++i)
+    {
+        const Rect& a = actual[i];
+        const Rect& b = expected[i];
+        if (a.left != b.left || a.top != b.top || a.right != b.right || a.bottom != b.bottom) return false;
+    }
+    return true;
+}
+
+void PrintRects(const std::vector<Rect>& rects)
+{
+    for (const Rect& rect : rects)
+    {
+        std::printf("    {%d, %d, %d, %d}\n", rect.left, rect.top, rect.right, rect.bottom);
+    }
+}
+
+void CheckRects(const std::vector<Rect>& actual, const std::vector<Rect>& expected, const char* what)
+{
+    Check(SameRects(actual, expected), what);
+    if (!SameRects(actual, expected))
+    {
+        PrintRects(actual);
+    }
+}
+
+// Every pixel is the snow colour where there is snow and transparent elsewhere
+void CheckPixels(const SnowLayerBitmap& layer, const SettledSnow& snow, const std::uint32_t pixel, const char* what)
+{
+    int wrong = 0;
+    for (int y = 0; y < snow.GetHeight(); ++y)
+    {
+        for (int x = 0; x < snow.GetWidth(); ++x)
+        {
+            wrong += layer.GetPixel(x, y) != (snow.IsSnow(x, y) ? pixel : 0u);
+        }
+    }
+    Check(wrong == 0, what);
+    if (wrong != 0)
+    {
+        std::printf("    %d pixels differ\n", wrong);
+    }
+}
+
+void TestDirtyRects()
+{
+    SnowGrid snow(WIDTH, HEIGHT, 1);
+    SnowLayerBitmap layer;
+
+    CheckRects(layer.Update(snow, SNOW_COLOR), {{0, 0, WIDTH, HEIGHT}}, "first update uploads the whole layer");
+    Check(layer.GetWidth() == WIDTH && layer.GetHeight() == HEIGHT, "layer takes the snow size");
+    CheckPixels(layer, snow, SNOW_PIXEL, "empty snow rasterizes as transparent");
+
+    CheckRects(layer.Update(snow, SNOW_COLOR), {}, "no change, no dirty rects");
+
+    // One word in each of three separate rows, including the partial last word
+    snow.SetSnow(199, 0);
+    snow.SetSnow(130, 50);
+    snow.SetSnow(10, 99);
+    snow.SetSnow(11, 99);
+    CheckRects(layer.Update(snow, SNOW_COLOR), {{192, 0, WIDTH, 1}, {128, 50, 192, 51}, {0, 99, 64, 100}},
+               "changed words of separate rows");
+    CheckPixels(layer, snow, SNOW_PIXEL, "single cells rasterize");
+    Check(layer.GetPixel(199, 0) == SNOW_PIXEL && layer.GetPixel(198, 0) == 0, "edge cell pixel");
+
+    // Rows changed one after another grow one rectangle
+    snow.SetSnow(5, 60);
+    snow.SetSnow(70, 61);
+    snow.SetSnow(140, 62);
+    CheckRects(layer.Update(snow, SNOW_COLOR), {{0, 60, 192, 63}}, "adjacent rows merge downwards");
+    CheckPixels(layer, snow, SNOW_PIXEL, "adjacent rows rasterize");
+
+    // Setting a cell that is already snow moves the row counter but not the cells
+    snow.SetSnow(5, 60);
+    CheckRects(layer.Update(snow, SNOW_COLOR), {}, "a row that changed back to the same cells is not dirty");
+
+    // More separate rows than MAX_DIRTY_RECTS fall back to the bounding box
+    for (int y = 2; y < 2 + 2 * static_cast<int>(SnowLayerBitmap::MAX_DIRTY_RECTS) + 2; y += 2)
+    {
+        snow.SetSnow(y, y);
+    }
+    CheckRects(layer.Update(snow, SNOW_COLOR), {{0, 2, 64, 35}}, "many rects merge into their bounding box");
+    CheckPixels(layer, snow, SNOW_PIXEL, "scattered rows rasterize");
+
+    // Settling moves snow around; whatever it did, the pixels follow
+    for (int x = 40; x < 160; ++x)
+    {
+        for (int y = 20; y < 40; ++y)
+        {
+            snow.SetSnow(x, y);
+        }
+    }
+    layer.Update(snow, SNOW_COLOR);
+    size_t settledRects = 0;
+    for (int pass = 0; pass < 50; ++pass)
+    {
+        snow.Settle(0, 0.0f);
+        const std::vector<Rect>& rects = layer.Update(snow, SNOW_COLOR);
+        settledRects += rects.size();
+        for (const Rect& rect : rects)
+        {
+            Check(rect.left >= 0 && rect.top >= 0 && rect.right <= WIDTH && rect.bottom <= HEIGHT &&
+                      rect.left < rect.right && rect.top < rect.bottom,
+                  "dirty rects stay inside the layer");
+        }
+    }
+    Check(settledRects > 0, "settling the block marks rows dirty");
+    CheckPixels(layer, snow, SNOW_PIXEL, "settled snow rasterizes");
+}
+
+void TestFullRewrites()
+{
+    SnowGrid snow(WIDTH, HEIGHT, 2);
+    SnowLayerBitmap layer;
+    for (int x = 0; x < WIDTH; x += 3)
+    {
+        snow.SetSnow(x, HEIGHT - 1);
+    }
+    layer.Update(snow, SNOW_COLOR);
+
+    layer.Invalidate();
+    CheckRects(layer.Update(snow, SNOW_COLOR), {{0, 0, WIDTH, HEIGHT}}, "Invalidate rewrites the whole layer");
+    CheckPixels(layer, snow, SNOW_PIXEL, "pixels after Invalidate");
+
+    const Color white{1.0f, 1.0f, 1.0f, 1.0f};
+    CheckRects(layer.Update(snow, white), {{0, 0, WIDTH, HEIGHT}}, "a colour change rewrites the whole layer");
+    CheckPixels(layer, snow, 0xFFFFFFFFu, "pixels in the new colour");
+
+    layer.Release();
+    Check(layer.GetWidth() == 0 && layer.GetHeight() == 0 && layer.GetDirtyRects().empty(),
+          "Release empties the layer");
+
+    // Snow that changed while released is picked up by the full rewrite
+    snow.SetSnow(100, 50);
+    CheckRects(layer.Update(snow, white), {{0, 0, WIDTH, HEIGHT}}, "Update after Release rewrites the whole layer");
+    CheckPixels(layer, snow, 0xFFFFFFFFu, "pixels after Release");
+    CheckRects(layer.Update(snow, white), {}, "and is incremental again afterwards");
+
+    // A display of another size starts over
+    SnowGrid larger(WIDTH + 64, HEIGHT, 3);
+    larger.SetSnow(WIDTH + 10, 0);
+    CheckRects(layer.Update(larger, white), {{0, 0, WIDTH + 64, HEIGHT}}, "a new size rewrites the whole layer");
+    CheckPixels(layer, larger, 0xFFFFFFFFu, "pixels after a resize");
+}
+
+void TestHeightmap()
+{
+    // The column model reads its rows back through the same interface
+    SnowHeightmap snow(WIDTH, HEIGHT, 4);
+    SnowLayerBitmap layer;
+    layer.Update(snow, SNOW_COLOR);
+
+    for (int i = 0; i < 5; ++i)
+    {
+        snow.SetSnow(70, 0);
+    }
+    CheckRects(layer.Update(snow, SNOW_COLOR), {{64, 95, 128, 100}}, "heightmap column grows one rect");
+    CheckPixels(layer, snow, SNOW_PIXEL, "heightmap pixels");
+}
+
+} // namespace
+
+int main()
+{
+    TestDirtyRects();
+    TestFullRewrites();
+    TestHeightmap();
+
+    if (failures != 0)
+    {
+        std::printf("%d snow layer checks failed\n", failures);
+        return 1;
+    }
+    std::printf("snow layer checks ok\n");
+    return 0;
+}
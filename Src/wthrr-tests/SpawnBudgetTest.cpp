@@ -0,0 +1,116 @@
+// Checks that WeatherSimulation spawns at most one frame's budget of rain and
+// snow per frame while fast-forwarding, when a frame runs many more steps
+// than the budget covers, and that the scene still fills up afterwards.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+
+#include "DisplayData.h"
+#include "RandomGenerator.h"
+#include "Settings.h"
+#include "SimulationClock.h"
+#include "WeatherSimulation.h"
+
+using RainEngine::ParticleEmitter;
+using RainEngine::SimulationClock;
+using RainEngine::WeatherSimulation;
+
+namespace {
+
+constexpr int MAX_PARTICLES = 75;
+constexpr double FRAME_SECONDS = 1.0 / 60.0;
+constexpr double FAST_FORWARD_SECONDS = 3.0;
+constexpr int SETTLE_FRAMES = 120; // Normal frames after the fast-forward, to finish filling
+
+// The per-step limits WeatherSimulation configures its emitters with
+size_t StepLimit(const ParticleType type, const float rate, const float stepSeconds)
+{
+    if (rate > 0.0f)
+    {
+        return static_cast<size_t>(std::ceil(rate * stepSeconds));
+    }
+    const size_t cap = static_cast<size_t>(MAX_PARTICLES) * (type == ParticleType::Rain ? 3 : 100);
+    const size_t ramp = type == ParticleType::Rain ? WeatherSimulation::RAIN_SPAWN_RAMP_STEPS
+                                                   : WeatherSimulation::SNOW_SPAWN_RAMP_STEPS;
+    return (cap + ramp - 1) / ramp;
+}
+
+int CheckBudget(const ParticleType type, const float rate, const char* name)
+{
+    RandomGenerator::GetInstance().Seed(7);
+
+    Setting settings;
+    settings.PartType = type;
+    settings.MaxParticles = MAX_PARTICLES;
+
+    DisplayData display;
+    static_cast<void>(display.SetSceneBounds(RainEngine::Rect{0, 0, 1920, 1032}, 1.0f));
+    WeatherSimulation simulation(&display, &settings);
+    simulation.SetSpawnRate(type, rate);
+
+    SimulationClock clock;
+    clock.FastForward(FAST_FORWARD_SECONDS);
+
+    const size_t budget = StepLimit(type, rate, clock.GetStepSeconds()) *
+                          static_cast<size_t>(clock.GetMaxStepsPerFrame());
+    size_t worstFrame = 0;
+    size_t total = 0;
+    int mostSteps = 0;
+    for (int normalFrames = 0; normalFrames < SETTLE_FRAMES;)
+    {
+        if (clock.GetFastForwardRemaining() <= 0.0)
+        {
+            ++normalFrames;
+        }
+        clock.BeginFrame(FRAME_SECONDS);
+        simulation.Advance(clock);
+
+        const ParticleEmitter& emitter =
+            type == ParticleType::Rain ? simulation.GetRainEmitter() : simulation.GetSnowEmitter();
+        worstFrame = std::max(worstFrame, emitter.GetFrameSpawned());
+        total += emitter.GetFrameSpawned();
+        mostSteps = std::max(mostSteps, clock.GetFrameSteps());
+    }
+
+    int failures = 0;
+    if (mostSteps <= clock.GetMaxStepsPerFrame())
+    {
+        std::printf("  %s: fast-forward never ran more than %d steps in a frame\n", name, mostSteps);
+        ++failures;
+    }
+    if (worstFrame > budget)
+    {
+        std::printf("  %s: %zu spawned in one frame, budget %zu\n", name, worstFrame, budget);
+        ++failures;
+    }
+    if (total == 0 || (rate <= 0.0f && type == ParticleType::Snow &&
+                       simulation.GetSnowField().Size() != static_cast<size_t>(MAX_PARTICLES) * 100))
+    {
+        std::printf("  %s: the scene did not fill, %zu spawned\n", name, total);
+        ++failures;
+    }
+
+    std::printf("%-24s up to %2d steps, %3zu of %3zu per frame, %5zu total: %s\n", name, mostSteps, worstFrame,
+                budget, total, failures ? "FAILED" : "ok");
+    return failures;
+}
+
+} // namespace
+
+int main()
+{
+    int failures = 0;
+    failures += CheckBudget(ParticleType::Rain, 0.0f, "rain, refill to cap");
+    failures += CheckBudget(ParticleType::Snow, 0.0f, "snow, refill to cap");
+    failures += CheckBudget(ParticleType::Rain, 3000.0f, "rain, 3000 per second");
+    failures += CheckBudget(ParticleType::Snow, 6000.0f, "snow, 6000 per second");
+
+    if (failures != 0)
+    {
+        std::printf("%d spawn budget checks failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+
+namespace RainEngine {
+
+// Platform-neutral value types used by the simulation core. They mirror the
+// layout of their Win32/Direct2D counterparts so the renderer can convert
+// them cheaply (see Win32Interop.h), but pull in no platform headers.
+
+// 0x00BBGGRR colour value, bit-compatible with Win32 COLORREF
+using ColorRef = std::uint32_t;
+
+// Integer rectangle with the same field order as Win32 RECT
+struct Rect {
+    std::int32_t left = 0;
+    std::int32_t top = 0;
+    std::int32_t right = 0;
+    std::int32_t bottom = 0;
+
+    [[nodiscard]] constexpr std::int32_t Width() const noexcept { return right - left; }
+    [[nodiscard]] constexpr std::int32_t Height() const noexcept { return bottom - top; }
+
+    [[nodiscard]] constexpr bool operator==(const Rect& other) const noexcept = default;
+};
+
+// Floating point 2D point, layout-compatible with D2D1_POINT_2F
+struct PointF {
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+// A rain drop reaching the ground during one simulation step. Hits are
+// collected per step and handed to consumers (puddles, ...) in one batch.
+struct GroundHit {
+    float x = 0.0f;
+    float y = 0.0f;
+    float radius = 0.0f;
+};
+
+// Straight (non-premultiplied) RGBA colour with 0..1 channels
+struct Color {
+    float r = 0.0f;
+    float g = 0.0f;
+    float b = 0.0f;
+    float a = 1.0f;
+
+    [[nodiscard]] static constexpr Color FromColorRef(ColorRef color, float alpha = 1.0f) noexcept {
+        return {
+            static_cast<float>(color & 0xFF) / 255.0f,
+            static_cast<float>((color >> 8) & 0xFF) / 255.0f,
+            static_cast<float>((color >> 16) & 0xFF) / 255.0f,
+            alpha
+        };
+    }
+
+    [[nodiscard]] constexpr bool operator==(const Color& other) const noexcept = default;
+};
+
+} // namespace RainEngine
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+
+namespace RainEngine {
+
+// Stateless, counter-based random numbers.
+//
+// Every value is a pure function of a key built from the caller's
+// coordinates (seed, step, position, purpose), so values can be drawn in any
+// order, on any thread, and come out the same on every run with the same
+// seed. Used where per-cell decisions must not depend on a shared generator.
+namespace CounterRandom {
+
+// splitmix64 finaliser: a bijective 64-bit mix with full avalanche
+[[nodiscard]] constexpr std::uint64_t Mix(std::uint64_t z) noexcept {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+inline constexpr std::uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ull;
+
+// Key for (seed, a, b, c, d); distinct inputs give independent keys
+[[nodiscard]] constexpr std::uint64_t Key(std::uint64_t seed, std::uint64_t a, std::uint64_t b,
+                                          std::uint64_t c = 0, std::uint64_t d = 0) noexcept {
+    std::uint64_t h = Mix(seed + GOLDEN_GAMMA);
+    h = Mix(h ^ (a + GOLDEN_GAMMA));
+    h = Mix(h ^ (b + 2 * GOLDEN_GAMMA));
+    h = Mix(h ^ (c + 3 * GOLDEN_GAMMA));
+    return Mix(h ^ (d + 4 * GOLDEN_GAMMA));
+}
+
+// The index-th 64 random bits of the stream named by key
+[[nodiscard]] constexpr std::uint64_t Bits(std::uint64_t key, std::uint64_t index = 0) noexcept {
+    return Mix(key + (index + 1) * GOLDEN_GAMMA);
+}
+
+// Uniform integer in [min, max] (inclusive), from the top bits of Bits(key, index)
+[[nodiscard]] constexpr int Int(std::uint64_t key, int min, int max, std::uint64_t index = 0) noexcept {
+    const std::uint64_t range = static_cast<std::uint64_t>(static_cast<std::int64_t>(max) - min) + 1;
+    return min + static_cast<int>(((Bits(key, index) >> 32) * range) >> 32);
+}
+
+// Uniform float in [0, 1)
+[[nodiscard]] constexpr float UnitFloat(std::uint64_t key, std::uint64_t index = 0) noexcept {
+    return static_cast<float>(Bits(key, index) >> 40) * (1.0f / 16777216.0f);
+}
+
+// 64 independent lanes, each set with probability threshold / 65536.
+// Bit-sliced comparison of 16-bit uniform lane values against threshold,
+// most significant bit first; stops as soon as every lane is decided.
+[[nodiscard]] constexpr std::uint64_t LaneMask(std::uint64_t key, std::uint32_t threshold) noexcept {
+    if (threshold == 0) return 0;
+    if (threshold >= 65536) return ~std::uint64_t{0};
+
+    std::uint64_t less = 0;
+    std::uint64_t equal = ~std::uint64_t{0};
+    for (int bit = 15; bit >= 0 && equal != 0; --bit) {
+        const std::uint64_t r = Bits(key, static_cast<std::uint64_t>(15 - bit));
+        if ((threshold >> bit) & 1u) {
+            less |= equal & ~r;
+            equal &= r;
+        } else {
+            equal &= ~r;
+        }
+    }
+    return less;
+}
+
+} // namespace CounterRandom
+
+} // namespace RainEngine
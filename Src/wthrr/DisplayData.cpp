@@ -1,33 +1,56 @@
 #include "DisplayData.h"
+#include "SnowGrid.h"
+#include "SnowHeightmap.h"
 #include "FastNoiseLite.h"
+#include "RandomGenerator.h"
 #include <algorithm>
-#include <limits>
+#include <cmath>
 #include <stdexcept>
 
 namespace RainEngine {
 
-DisplayData::DisplayData(ID2D1DeviceContext* dc) : deviceContext_(dc) {
-    if (!dc) {
-        throw std::invalid_argument("Device context cannot be null");
-    }
-    
+DisplayData::DisplayData() {
     // Initialize noise generator with modern smart pointer
     noiseGenerator_ = std::make_unique<FastNoiseLite>();
     noiseGenerator_->SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
+
+    // Each display settles its snow from its own seed unless one is set explicitly
+    snowSeed_ = RandomGenerator::GetInstance().WithEngine([](auto& engine) {
+        return (static_cast<std::uint64_t>(engine()) << 32) ^ static_cast<std::uint64_t>(engine());
+    });
     
     // Initialize legacy compatibility members
     pNoiseGen = noiseGenerator_.get();
-    pScenePixels = nullptr;
+    pSettledSnow = nullptr;
     
     // Sync public members with private ones
     SyncPublicMembers();
 }
 
-Result DisplayData::SetRainColor(const COLORREF color) noexcept {
+DisplayData::~DisplayData() = default;
+
+#ifdef _WIN32
+DisplayData::DisplayData(ID2D1DeviceContext* dc) : DisplayData() {
+    if (!dc) {
+        throw std::invalid_argument("Device context cannot be null");
+    }
+    deviceContext_ = dc;
+}
+#endif
+
+Result DisplayData::SetRainColor(const ColorRef color) noexcept {
+    rainColor_ = Color::FromColorRef(color);
+
+    #ifdef _WIN32
+    // Headless displays have no render resources to rebuild
+    if (!deviceContext_) {
+        return Result::Success();
+    }
+
     try {
-        const auto red = static_cast<float>(GetRValue(color)) / 255.0f;
-        const auto green = static_cast<float>(GetGValue(color)) / 255.0f;
-        const auto blue = static_cast<float>(GetBValue(color)) / 255.0f;
+        const auto red = rainColor_.r;
+        const auto green = rainColor_.g;
+        const auto blue = rainColor_.b;
 
         // Create main drop brush with full opacity
         const auto hr = deviceContext_->CreateSolidColorBrush(
@@ -40,8 +63,24 @@ Result DisplayData::SetRainColor(const COLORREF color) noexcept {
                                "Failed to create drop color brush");
         }
 
+        // The overlay brush is white whatever the rain color, so it is made once
+        if (!overlayBrush_) {
+            const auto overlayHr = deviceContext_->CreateSolidColorBrush(
+                D2D1::ColorF(D2D1::ColorF::White, 1.0f),
+                overlayBrush_.GetAddressOf()
+            );
+
+            if (FAILED(overlayHr)) {
+                return Result::Error(Result::ErrorCode::DirectXError,
+                                   "Failed to create overlay brush");
+            }
+        }
+
         // Create splatter brushes with varying opacity
         auto result = CreateSplatterBrushes(red, green, blue);
+        if (result.IsSuccess()) {
+            result = CreateDropOpacityBrushes(red, green, blue);
+        }
         if (result.IsSuccess()) {
             SyncPublicMembers();
         }
@@ -53,8 +92,13 @@ Result DisplayData::SetRainColor(const COLORREF color) noexcept {
         return Result::Error(Result::ErrorCode::ResourceAllocationFailed, 
                            "Unknown error in SetRainColor");
     }
+    #else
+    return Result::Success();
+    #endif
 }
 
+#ifdef _WIN32
+
 Result DisplayData::CreateSplatterBrushes(const float red, const float green, const float blue) noexcept {
     try {
         // Clear existing brushes
@@ -86,16 +130,58 @@ Result DisplayData::CreateSplatterBrushes(const float red, const float green, co
     }
 }
 
-Result DisplayData::SetSceneBounds(const RECT& sceneRect, const float scaleFactor) noexcept {
+Result DisplayData::CreateDropOpacityBrushes(const float red, const float green, const float blue) noexcept {
     try {
-        // Check if bounds have changed and deallocate old scene pixels if needed
-        if (!IsSameRect(sceneRect_, sceneRect)) {
-            scenePixels_.reset(); // Smart pointer automatic cleanup
+        dropOpacityBrushes_.clear();
+        dropOpacityBrushes_.reserve(DROP_OPACITY_LEVELS_);
+
+        for (int i = 0; i < DROP_OPACITY_LEVELS_; ++i) {
+            const auto alpha = static_cast<float>(i) / static_cast<float>(DROP_OPACITY_LEVELS_ - 1);
+
+            Microsoft::WRL::ComPtr<ID2D1SolidColorBrush> brush;
+            const auto hr = deviceContext_->CreateSolidColorBrush(D2D1::ColorF(red, green, blue, alpha),
+                                                                  brush.GetAddressOf());
+
+            if (FAILED(hr)) {
+                dropOpacityBrushes_.clear();
+                return Result::Error(Result::ErrorCode::DirectXError,
+                                   "Failed to create drop opacity brush at index " + std::to_string(i));
+            }
+
+            dropOpacityBrushes_.emplace_back(std::move(brush));
         }
 
+        return Result::Success();
+
+    } catch (const std::exception& e) {
+        dropOpacityBrushes_.clear();
+        return Result::Error(Result::ErrorCode::ResourceAllocationFailed, e.what());
+    } catch (...) {
+        dropOpacityBrushes_.clear();
+        return Result::Error(Result::ErrorCode::ResourceAllocationFailed,
+                           "Unknown error in CreateDropOpacityBrushes");
+    }
+}
+#endif
+
+void DisplayData::SetSnowSeed(const std::uint64_t seed) noexcept {
+    snowSeed_ = seed;
+    if (settledSnow_) {
+        settledSnow_->Reseed(seed);
+    }
+}
+
+Result DisplayData::SetSceneBounds(const Rect& sceneRect, const float scaleFactor) noexcept {
+    try {
+        const Rect previousRect = sceneRect_;
         sceneRect_ = sceneRect;
         scaleFactor_ = scaleFactor;
 
+        // Check if bounds or cell size have changed and deallocate old settled snow if needed
+        if (!IsSameRect(previousRect, sceneRect) || EffectiveSnowCellSize() != snowCellSize_) {
+            settledSnow_.reset(); // Smart pointer automatic cleanup
+        }
+
         // Calculate normalized rectangle
         sceneRectNorm_ = {
             0, 0,
@@ -112,23 +198,9 @@ Result DisplayData::SetSceneBounds(const RECT& sceneRect, const float scaleFacto
                                "Scene dimensions must be positive");
         }
 
-        // Allocate scene pixels if needed
-        if (!scenePixels_) {
-            const auto totalPixels = static_cast<size_t>(width_) * static_cast<size_t>(height_);
-            
-            // Check for potential overflow
-            const auto maxSizeT = (std::numeric_limits<size_t>::max)();
-            if (totalPixels > maxSizeT / sizeof(bool)) {
-                return Result::Error(Result::ErrorCode::ResourceAllocationFailed,
-                                   "Scene dimensions too large for allocation");
-            }
-            
-            scenePixels_ = std::make_unique<bool[]>(totalPixels);
-            
-            // Initialize to false (air)
-            std::fill_n(scenePixels_.get(), totalPixels, false);
-            
-            maxSnowHeight_ = height_ - 2;
+        // Allocate the settled snow if needed (starts as all air)
+        if (!settledSnow_) {
+            CreateSettledSnow();
         }
 
         // Sync public members after changes
@@ -138,7 +210,7 @@ Result DisplayData::SetSceneBounds(const RECT& sceneRect, const float scaleFacto
         
     } catch (const std::bad_alloc&) {
         return Result::Error(Result::ErrorCode::ResourceAllocationFailed,
-                           "Failed to allocate scene pixel buffer");
+                           "Failed to allocate settled snow");
     } catch (const std::exception& e) {
         return Result::Error(Result::ErrorCode::ResourceAllocationFailed, e.what());
     } catch (...) {
@@ -147,6 +219,89 @@ Result DisplayData::SetSceneBounds(const RECT& sceneRect, const float scaleFacto
     }
 }
 
+Result DisplayData::SetSnowModel(const SnowModelType model) noexcept {
+    if (model == snowModel_) {
+        return Result::Success();
+    }
+    snowModel_ = model;
+
+    // Nothing to replace before the scene bounds are known
+    if (!settledSnow_) {
+        return Result::Success();
+    }
+
+    try {
+        CreateSettledSnow();
+        SyncPublicMembers();
+        return Result::Success();
+    } catch (const std::bad_alloc&) {
+        settledSnow_.reset();
+        SyncPublicMembers();
+        return Result::Error(Result::ErrorCode::ResourceAllocationFailed,
+                           "Failed to allocate settled snow");
+    }
+}
+
+Result DisplayData::SetSnowCellSize(const int cellSize) noexcept {
+    if (cellSize < 0) {
+        return Result::Error(Result::ErrorCode::InvalidParameter,
+                           "Snow cell size must not be negative");
+    }
+    snowCellSetting_ = std::min(cellSize, MAX_SNOW_CELL_SIZE_);
+
+    // Nothing to rebuild before the scene bounds are known or when the size stays
+    if (!settledSnow_ || EffectiveSnowCellSize() == snowCellSize_) {
+        return Result::Success();
+    }
+
+    try {
+        CreateSettledSnow();
+        SyncPublicMembers();
+        return Result::Success();
+    } catch (const std::bad_alloc&) {
+        settledSnow_.reset();
+        SyncPublicMembers();
+        return Result::Error(Result::ErrorCode::ResourceAllocationFailed,
+                           "Failed to allocate settled snow");
+    }
+}
+
+int DisplayData::CellSizeForScale(const float scaleFactor) noexcept {
+    // Whole pixels only, so cells stay crisp under nearest-neighbour scaling
+    return std::clamp(static_cast<int>(std::lround(scaleFactor)), 1, MAX_SNOW_CELL_SIZE_);
+}
+
+int DisplayData::EffectiveSnowCellSize() const noexcept {
+    return snowCellSetting_ > 0 ? snowCellSetting_ : CellSizeForScale(scaleFactor_);
+}
+
+void DisplayData::ReleaseSettledSnow() noexcept {
+    if (settledSnow_) {
+        settledSnow_->Clear();
+    }
+    snowGeometry_.Release();
+    snowLayer_.Release();
+    maxSnowHeight_ = settledSnow_ ? settledSnow_->GetHeight() - 2 : 0;
+    MaxSnowHeight = maxSnowHeight_;
+}
+
+void DisplayData::CreateSettledSnow() {
+    settledSnow_.reset();
+
+    // A partial cell at the right or bottom edge still counts as a whole one
+    snowCellSize_ = EffectiveSnowCellSize();
+    const int cellsWide = (width_ + snowCellSize_ - 1) / snowCellSize_;
+    const int cellsHigh = (height_ + snowCellSize_ - 1) / snowCellSize_;
+    if (snowModel_ == SnowModelType::Heightmap) {
+        settledSnow_ = std::make_unique<SnowHeightmap>(cellsWide, cellsHigh, snowSeed_);
+    } else {
+        settledSnow_ = std::make_unique<SnowGrid>(cellsWide, cellsHigh, snowSeed_);
+    }
+    snowGeometry_.Invalidate();
+    snowLayer_.Invalidate();
+    maxSnowHeight_ = cellsHigh - 2;
+}
+
 void DisplayData::SyncPublicMembers() noexcept {
     // Synchronize public members with private ones for backward compatibility
     SceneRect = sceneRect_;
@@ -155,13 +310,18 @@ void DisplayData::SyncPublicMembers() noexcept {
     Width = width_;
     Height = height_;
     MaxSnowHeight = maxSnowHeight_;
+    SnowCellSize = snowCellSize_;
     
+    #ifdef _WIN32
     // Sync brush references
     DropColorBrush = dropColorBrush_;
     PrebuiltSplatterOpacityBrushes = splatterOpacityBrushes_;
+    #endif
     
     // Sync pointers
-    pScenePixels = scenePixels_.get();
+    pSettledSnow = settledSnow_.get();
+    pSnowGeometry = &snowGeometry_;
+    pSnowLayer = &snowLayer_;
     pNoiseGen = noiseGenerator_.get();
 }
 
@@ -1,14 +1,19 @@
 #pragma once
 
-#include <d2d1.h>
 #include <vector>
 #include <memory>
-#ifdef __cpp_lib_span
-    #include <span>
+#ifdef _WIN32
+    #include <d2d1.h>
+    #include <dcomp.h>
+    #include <wrl/client.h>
 #endif
-#include <dcomp.h>
-#include <wrl/client.h>
+#include "CoreTypes.h"
+#include "DrawRecorder.h"
 #include "ErrorHandling.h"
+#include "Settings.h"
+#include "SettledSnow.h"
+#include "SettledSnowGeometry.h"
+#include "SnowLayerBitmap.h"
 
 class FastNoiseLite;
 
@@ -16,39 +21,73 @@ namespace RainEngine {
 
 class DisplayData {
 public:
+    // Headless construction: simulation state only, no render resources
+    DisplayData();
+    #ifdef _WIN32
     explicit DisplayData(ID2D1DeviceContext* dc);
-    ~DisplayData() = default;
+    #endif
+    ~DisplayData(); // Out of line: FastNoiseLite is incomplete here
 
     // Modern RAII-based methods with error handling
-    [[nodiscard]] Result SetRainColor(COLORREF color) noexcept;
-    [[nodiscard]] Result SetSceneBounds(const RECT& sceneRect, float scaleFactor) noexcept;
+    [[nodiscard]] Result SetRainColor(ColorRef color) noexcept;
+    [[nodiscard]] Result SetSceneBounds(const Rect& sceneRect, float scaleFactor) noexcept;
     
     // Getters with const correctness
     [[nodiscard]] constexpr int GetWidth() const noexcept { return width_; }
     [[nodiscard]] constexpr int GetHeight() const noexcept { return height_; }
     [[nodiscard]] constexpr float GetScaleFactor() const noexcept { return scaleFactor_; }
-    [[nodiscard]] constexpr const RECT& GetSceneRect() const noexcept { return sceneRect_; }
-    [[nodiscard]] constexpr const RECT& GetSceneRectNorm() const noexcept { return sceneRectNorm_; }
-    [[nodiscard]] constexpr int GetMaxSnowHeight() const noexcept { return maxSnowHeight_; }
-
-    // Scene pixels interface with span fallback
-    #ifdef __cpp_lib_span
-    [[nodiscard]] std::span<bool> GetScenePixels() noexcept {
-        return scenePixels_ ? std::span<bool>{scenePixels_.get(), static_cast<size_t>(width_ * height_)} : std::span<bool>{};
-    }
-    [[nodiscard]] std::span<const bool> GetScenePixels() const noexcept {
-        return scenePixels_ ? std::span<const bool>{scenePixels_.get(), static_cast<size_t>(width_ * height_)} : std::span<const bool>{};
-    }
-    #else
-    // Fallback for compilers without std::span
-    [[nodiscard]] bool* GetScenePixelsRaw() noexcept { return scenePixels_.get(); }
-    [[nodiscard]] const bool* GetScenePixelsRaw() const noexcept { return scenePixels_.get(); }
-    [[nodiscard]] size_t GetScenePixelCount() const noexcept { return static_cast<size_t>(width_ * height_); }
-    #endif
-
+    [[nodiscard]] constexpr const Rect& GetSceneRect() const noexcept { return sceneRect_; }
+    [[nodiscard]] constexpr const Rect& GetSceneRectNorm() const noexcept { return sceneRectNorm_; }
+    [[nodiscard]] constexpr int GetMaxSnowHeight() const noexcept { return maxSnowHeight_; } // In snow cells
+    [[nodiscard]] constexpr const Color& GetRainColor() const noexcept { return rainColor_; }
+
+    // Settled snow, null until SetSceneBounds has run
+    [[nodiscard]] SettledSnow* GetSettledSnow() noexcept { return settledSnow_.get(); }
+    [[nodiscard]] const SettledSnow* GetSettledSnow() const noexcept { return settledSnow_.get(); }
+
+    // Clear the settled snow and free its cells and render caches; the
+    // model keeps only its fixed-size bookkeeping
+    void ReleaseSettledSnow() noexcept;
+
+    // Storage and settling rules for settled snow. Switching models drops
+    // the snow settled so far.
+    [[nodiscard]] Result SetSnowModel(SnowModelType model) noexcept;
+    [[nodiscard]] constexpr SnowModelType GetSnowModel() const noexcept { return snowModel_; }
+
+    // Scene pixels per side of a settled snow cell. cellSize 0 follows the
+    // scale factor (one cell per 1080p pixel), so a 4K scene settles the
+    // same number of cells as a 1080p one. Changing the effective size
+    // drops the snow settled so far.
+    [[nodiscard]] Result SetSnowCellSize(int cellSize) noexcept;
+    [[nodiscard]] constexpr int GetSnowCellSize() const noexcept { return snowCellSize_; }
+    [[nodiscard]] static int CellSizeForScale(float scaleFactor) noexcept;
+
+    // Cached draw shapes of the settled snow, refreshed by the renderer
+    [[nodiscard]] SettledSnowGeometry& GetSnowGeometry() noexcept { return snowGeometry_; }
+
+    // Settled snow as a bitmap layer, for the bitmap render mode
+    [[nodiscard]] SnowLayerBitmap& GetSnowLayer() noexcept { return snowLayer_; }
+
+    // Primitives of the field being drawn, recorded by Draw and then replayed
+    [[nodiscard]] DrawRecorder& GetDrawCommands() noexcept { return drawCommands_; }
+
+    #ifdef _WIN32
     // Accessors for brushes
     [[nodiscard]] ID2D1SolidColorBrush* GetDropColorBrush() const noexcept { return dropColorBrush_.Get(); }
     [[nodiscard]] const auto& GetSplatterOpacityBrushes() const noexcept { return splatterOpacityBrushes_; }
+
+    // Drop color at an opacity, rounded to one of DROP_OPACITY_LEVELS_ prebuilt
+    // brushes so draw paths never create brushes of their own
+    [[nodiscard]] ID2D1SolidColorBrush* GetDropOpacityBrush(const float opacity) const noexcept {
+        if (dropOpacityBrushes_.empty()) return dropColorBrush_.Get();
+        const float clamped = opacity < 0.0f ? 0.0f : opacity > 1.0f ? 1.0f : opacity;
+        return dropOpacityBrushes_[static_cast<size_t>(clamped * (DROP_OPACITY_LEVELS_ - 1) + 0.5f)].Get();
+    }
+
+    // Shared opaque white brush for full-scene overlays. Callers set its
+    // opacity before each draw.
+    [[nodiscard]] ID2D1SolidColorBrush* GetOverlayBrush() const noexcept { return overlayBrush_.Get(); }
+    #endif
     
     // Noise generator access
     [[nodiscard]] FastNoiseLite* GetNoiseGenerator() const noexcept { return noiseGenerator_.get(); }
@@ -56,47 +95,77 @@ public:
     // Setters
     void SetMaxSnowHeight(int height) noexcept { maxSnowHeight_ = height; }
 
+    // Seed for the settled snow rules; applies to the current and any future model
+    void SetSnowSeed(std::uint64_t seed) noexcept;
+    [[nodiscard]] constexpr std::uint64_t GetSnowSeed() const noexcept { return snowSeed_; }
+
     // Direct member access for legacy compatibility
-    RECT SceneRect;
-    RECT SceneRectNorm;
+    Rect SceneRect;
+    Rect SceneRectNorm;
     float ScaleFactor;
     int Width;
     int Height;
-    int MaxSnowHeight;
+    int MaxSnowHeight;   // Highest settled snow row, in snow cells
+    int SnowCellSize;    // Scene pixels per snow cell
     
-    // Legacy brush and pointer access
+    #ifdef _WIN32
+    // Legacy brush access
     Microsoft::WRL::ComPtr<ID2D1SolidColorBrush> DropColorBrush;
     std::vector<Microsoft::WRL::ComPtr<ID2D1SolidColorBrush>> PrebuiltSplatterOpacityBrushes;
-    bool* pScenePixels;
+    #endif
+
+    // Legacy pointer access
+    SettledSnow* pSettledSnow;
+    SettledSnowGeometry* pSnowGeometry;
+    SnowLayerBitmap* pSnowLayer;
     FastNoiseLite* pNoiseGen;
 
 private:
     static constexpr int MAX_SPLUTTER_FRAME_COUNT_ = 50;
+    static constexpr int MAX_SNOW_CELL_SIZE_ = 16;
+    static constexpr int DROP_OPACITY_LEVELS_ = 64;
     
     // Private data members with modern naming convention
     int width_ = 100;
     int height_ = 100;
     float scaleFactor_ = 1.0f;
     int maxSnowHeight_ = 0;
+    std::uint64_t snowSeed_ = 0;
+    SnowModelType snowModel_ = SnowModelType::Grid;
+    int snowCellSetting_ = 0; // Requested cell size, 0 = follow the scale factor
+    int snowCellSize_ = 1;    // Cell size the current model was built with
 
-    RECT sceneRect_{0, 0, 100, 100};
-    RECT sceneRectNorm_{0, 0, 100, 100};
+    Rect sceneRect_{0, 0, 100, 100};
+    Rect sceneRectNorm_{0, 0, 100, 100};
+    Color rainColor_{};
 
-    ID2D1DeviceContext* deviceContext_; // Non-owning pointer
+    #ifdef _WIN32
+    ID2D1DeviceContext* deviceContext_ = nullptr; // Non-owning pointer, null when headless
     Microsoft::WRL::ComPtr<ID2D1SolidColorBrush> dropColorBrush_;
     std::vector<Microsoft::WRL::ComPtr<ID2D1SolidColorBrush>> splatterOpacityBrushes_;
+    std::vector<Microsoft::WRL::ComPtr<ID2D1SolidColorBrush>> dropOpacityBrushes_;
+    Microsoft::WRL::ComPtr<ID2D1SolidColorBrush> overlayBrush_;
+    #endif
 
     // Modern smart pointer management
-    std::unique_ptr<bool[]> scenePixels_;
+    std::unique_ptr<SettledSnow> settledSnow_;
+    SettledSnowGeometry snowGeometry_;
+    SnowLayerBitmap snowLayer_;
+    DrawRecorder drawCommands_;
     std::unique_ptr<FastNoiseLite> noiseGenerator_;
 
     // Helper methods
-    [[nodiscard]] static constexpr bool IsSameRect(const RECT& lhs, const RECT& rhs) noexcept {
+    [[nodiscard]] static constexpr bool IsSameRect(const Rect& lhs, const Rect& rhs) noexcept {
         return lhs.left == rhs.left && lhs.top == rhs.top &&
                lhs.right == rhs.right && lhs.bottom == rhs.bottom;
     }
 
+    #ifdef _WIN32
     [[nodiscard]] Result CreateSplatterBrushes(float red, float green, float blue) noexcept;
+    [[nodiscard]] Result CreateDropOpacityBrushes(float red, float green, float blue) noexcept;
+    #endif
+    void CreateSettledSnow();
+    [[nodiscard]] int EffectiveSnowCellSize() const noexcept;
     void SyncPublicMembers() noexcept;
 };
 
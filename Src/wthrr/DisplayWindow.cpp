@@ -1,6 +1,5 @@
 #include "DisplayWindow.h"
 
-#include <chrono>
 #include <cstdlib>
 #include <shellapi.h>
 #include <commctrl.h>
@@ -12,9 +11,7 @@
 #include "MathUtil.h"
 #include "Resource.h"
 #include "SettingsManager.h"
-#include "SnowFlake.h"
-#include "RandomGenerator.h"
-#include "FastNoiseLite.h"
+#include "Win32Interop.h"
 
 #ifndef HINST_THISCOMPONENT
 EXTERN_C IMAGE_DOS_HEADER __ImageBase;
@@ -115,17 +112,12 @@ HRESULT DisplayWindow::Initialize(const HINSTANCE hInstance, const MonitorData&
 	InitDirect2D(window);
 	pDisplaySpecificData = new DisplayData(Dc.Get());
 	pDisplaySpecificData->SetRainColor(GeneralSettings.ParticleColor);
+	pDisplaySpecificData->SetSnowModel(GeneralSettings.SnowModel);
+	pDisplaySpecificData->SetSnowCellSize(GeneralSettings.SnowCellSize);
 	HandleWindowBoundsChange(window, false);
 
-	// Initialize puddle manager
-	pPuddleManager = std::make_unique<PuddleManager>(pDisplaySpecificData);
-	
-	// Initialize snow wind system with default values
-	CurrentSnowWindDirection = 0.0f;
-	TargetSnowWindDirection = 0.0f;
-	WindTransitionProgress = 1.0f;
-	LastWindChangeTime = GetCurrentTimeInSeconds();
-	NextWindChangeTime = LastWindChangeTime + 5.0; // First change in 5 seconds
+	// Initialize the particle, puddle, lightning and snow wind simulation
+	pSimulation = std::make_unique<RainEngine::WeatherSimulation>(pDisplaySpecificData, &GeneralSettings);
 
 	// Set the window to the bottom of the Z-order so it appears behind other windows
 	SetWindowPos(window, HWND_BOTTOM, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE | SWP_NOACTIVATE);
@@ -305,62 +297,10 @@ LRESULT DisplayWindow::WndProc(const HWND hWnd, const UINT message, const WPARAM
 	return DefWindowProc(hWnd, message, wParam, lParam);
 }
 
-double DisplayWindow::GetCurrentTimeInSeconds()
+void DisplayWindow::Animate(const RainEngine::SimulationClock& clock)
 {
-	using namespace std::chrono;
-	return duration<double>(high_resolution_clock::now().time_since_epoch()).count();
-}
-
-void DisplayWindow::Animate()
-{
-	// Target a stable physics time step of 1/120th of a second (more precise than previous 0.01)
-	constexpr double fixedTimeStep = 1.0 / 120.0;
-
-	if (CurrentTime < 0)
-	{
-		CurrentTime = GetCurrentTimeInSeconds();
-		return; // Skip the first frame to establish timing
-	}
-	
-	// Calculate actual frame time
-	const double newTime = GetCurrentTimeInSeconds();
-	double frameTime = newTime - CurrentTime;
-	CurrentTime = newTime;
-	
-	// Cap maximum frame time to avoid "spiral of death" with very long frames
-	if (frameTime > 0.25)
-		frameTime = 0.25;
-		
-	// Add frame time to the accumulator
-	Accumulator += frameTime;
-
-	// Update with a fixed time step for physics stability
-	int stepCount = 0;
-	while (Accumulator >= fixedTimeStep && stepCount < 3) // Limit max steps per frame
-	{
-		// Update particle systems with fixed time step
-		if (GeneralSettings.PartType == RAIN)
-		{
-			UpdateRainDrops(fixedTimeStep);
-		}
-		else if (GeneralSettings.PartType == SNOW)
-		{
-			// Update snow wind system if enabled
-			if (GeneralSettings.EnableSnowWind)
-			{
-				UpdateSnowWind(fixedTimeStep);
-			}
-			
-			UpdateSnowFlakes(fixedTimeStep);
-		}
-		
-		// Update lightning flash system
-		UpdateLightning();
-		
-		// Consume accumulated time
-		Accumulator -= fixedTimeStep;
-		stepCount++;
-	}
+	// Run the fixed steps the frame loop's clock handed out for this frame
+	pSimulation->Advance(clock);
 	
 	// Draw the current state
 	if (GeneralSettings.PartType == RAIN)
@@ -373,111 +313,6 @@ void DisplayWindow::Animate()
 	}	
 }
 
-void DisplayWindow::UpdateSnowWind(const float deltaTime)
-{
-	const double currentTime = GetCurrentTimeInSeconds();
-	
-	// Check if it's time to change the wind direction
-	if (currentTime >= NextWindChangeTime)
-	{
-		// Calculate how often the wind changes based on variability (0-100)
-		// Higher variability means more frequent changes (2-15 seconds)
-		// Reduced minimum time slightly to make wind changes more noticeable
-		const float variabilityFactor = GeneralSettings.SnowWindVariability / 100.0f;
-		const float changeDuration = 15.0f - (variabilityFactor * 13.0f);  // 2-15 seconds
-		
-		// Calculate how strong the wind is based on intensity (0-100)
-		// Higher intensity means stronger wind (-8 to 8) - increased range for visibility
-		// Increased the strength range from 4.0 to 8.0 to make wind more noticeable
-		const float intensityFactor = GeneralSettings.SnowWindIntensity / 100.0f;
-		const float maxWindStrength = 8.0f * intensityFactor;
-		
-		// Set the previous and target wind directions
-		CurrentSnowWindDirection = TargetSnowWindDirection;
-		
-		// Generate a new target wind direction with more dramatic shifts
-		auto& rng = RandomGenerator::GetInstance();
-		
-		// Make wind changes more dramatic by having more variance between directions
-		// Reduced continuity factor to allow more dramatic shifts
-		const float windContinuityFactor = 0.1f;  // Reduced from 0.3 for more dramatic shifts
-		
-		// Make wind shifts more pronounced by sometimes forcing direction change
-		// If the current wind is weak or we need a dramatic change
-		if (fabsf(CurrentSnowWindDirection) < 1.0f || rng.GenerateFloat(0.0f, 1.0f) < 0.3f) {
-			// Create more dramatic wind shift
-			const float randomComponent = rng.GenerateFloat(-maxWindStrength, maxWindStrength);
-			// Force wind to blow in a more noticeable direction, avoiding near-zero values
-			if (fabsf(randomComponent) < 2.0f) {
-				TargetSnowWindDirection = randomComponent > 0 ? 2.0f : -2.0f;
-			} else {
-				TargetSnowWindDirection = randomComponent;
-			}
-		}
-		else {
-			// Normal wind shift with some continuity
-			const float randomComponent = rng.GenerateFloat(-maxWindStrength, maxWindStrength);
-			TargetSnowWindDirection = (CurrentSnowWindDirection * windContinuityFactor) + 
-									  (randomComponent * (1.0f - windContinuityFactor));
-		}
-		
-		// Cap the target wind strength
-		if (TargetSnowWindDirection > maxWindStrength)
-			TargetSnowWindDirection = maxWindStrength;
-		if (TargetSnowWindDirection < -maxWindStrength)
-			TargetSnowWindDirection = -maxWindStrength;
-		
-		// Reset transition progress
-		WindTransitionProgress = 0.0f;
-		
-		// Schedule next wind change with some randomness for natural variation
-		LastWindChangeTime = currentTime;
-		NextWindChangeTime = currentTime + changeDuration + (rng.GenerateFloat(-2.0f, 2.0f));
-	}
-	
-	// Update wind transition - slightly faster transitions for more noticeable effect
-	if (WindTransitionProgress < 1.0f)
-	{
-		// Transition more quickly for more dramatic wind changes
-		// Increased transition speed for more visible changes
-		float transitionSpeed = 0.3f + 
-		                       (GeneralSettings.SnowWindVariability / 100.0f * 0.4f);
-		
-		WindTransitionProgress += deltaTime * transitionSpeed;
-		if (WindTransitionProgress > 1.0f)
-		{
-			WindTransitionProgress = 1.0f;
-		}
-	}
-}
-
-float DisplayWindow::GetCurrentSnowWindFactor() const
-{
-	if (!GeneralSettings.EnableSnowWind)
-	{
-		return 0.0f;
-	}
-	
-	// Use smooth transition between wind directions
-	const float t = WindTransitionProgress;
-	
-	// Modified easing function for more dramatic initial and final movements
-	// This makes wind changes more noticeable at start and end of transition
-	float easedT;
-	if (t < 0.5f) {
-		// Sharper initial acceleration (more noticeable start)
-		easedT = 2.0f * t * t;
-	}
-	else {
-		// Sharper deceleration at the end (more noticeable finish)
-		const float f = (1.0f - t);
-		easedT = 1.0f - 2.0f * f * f;
-	}
-	
-	// Interpolate between current and target wind directions
-	return CurrentSnowWindDirection * (1.0f - easedT) + TargetSnowWindDirection * easedT;
-}
-
 void DisplayWindow::InitNotifyIcon(const HWND hWnd)
 {
 	NOTIFYICONDATA nid = {sizeof(nid)};
@@ -608,15 +443,15 @@ void DisplayWindow::InitDirect2D(const HWND hWnd)
 
 void DisplayWindow::HandleWindowBoundsChange(const HWND window, const bool clearDrops)
 {
-	RECT sceneRect;
+	RainEngine::Rect sceneRect;
 	float scaleFactor = 1.0f;
 	// find screen rect which removes the taskbar at the bottom
 	FindSceneRect(sceneRect, scaleFactor);
 	if (sceneRect != pDisplaySpecificData->SceneRect)
 	{
-		if (!RainDrops.empty() && clearDrops)
+		if (pSimulation && clearDrops)
 		{
-			RainDrops.clear();
+			pSimulation->ClearRainDrops();
 		}
 		pDisplaySpecificData->SetSceneBounds(sceneRect, scaleFactor);
 
@@ -631,15 +466,15 @@ void DisplayWindow::HandleWindowBoundsChange(const HWND window, const bool clear
 		OutputDebugStringW(logMessage.c_str());
 	}
 
-	if (pPuddleManager && clearDrops)
+	if (pSimulation && clearDrops)
 	{
-		pPuddleManager->Reset();
+		pSimulation->ResetPuddles();
 	}
 }
 
 void DisplayWindow::HandleTaskBarChange() const
 {
-	RECT sceneRect;
+	RainEngine::Rect sceneRect;
 	float scaleFactor = 1.0f;
 	FindSceneRect(sceneRect, scaleFactor);
 	if (sceneRect != pDisplaySpecificData->SceneRect)
@@ -658,7 +493,7 @@ void DisplayWindow::HandleTaskBarChange() const
 	}
 }
 
-void DisplayWindow::FindSceneRect(RECT& sceneRect, float& scaleFactor) const
+void DisplayWindow::FindSceneRect(RainEngine::Rect& sceneRect, float& scaleFactor) const
 {
 	std::vector<MonitorData> monitorDataList;
 	EnumDisplayMonitors(nullptr, nullptr, MonitorEnumProc, reinterpret_cast<LPARAM>(&monitorDataList));
@@ -689,10 +524,11 @@ void DisplayWindow::FindSceneRect(RECT& sceneRect, float& scaleFactor) const
 				}
 			}
 
-			RECT taskBarRect;
-			GetWindowRect(hTaskbarWnd, &taskBarRect);
+			RECT taskBarWindowRect;
+			GetWindowRect(hTaskbarWnd, &taskBarWindowRect);
 
-			RECT desktopRect = monitorData.MonitorRect;
+			const RainEngine::Rect taskBarRect = RainEngine::ToRect(taskBarWindowRect);
+			const RainEngine::Rect desktopRect = RainEngine::ToRect(monitorData.MonitorRect);
 
 			const int monitorHeight = desktopRect.bottom - desktopRect.top;
 			scaleFactor = static_cast<float>(monitorHeight) / 1080.0f;
@@ -720,7 +556,7 @@ void DisplayWindow::FindSceneRect(RECT& sceneRect, float& scaleFactor) const
 	}
 }
 
-void DisplayWindow::FindSceneRect2(RECT& sceneRect, float& scaleFactor) const
+void DisplayWindow::FindSceneRect2(RainEngine::Rect& sceneRect, float& scaleFactor) const
 {
 	HWND hTaskbarWnd;
 	if (MonitorDat.IsPrimaryDisplay)
@@ -735,18 +571,21 @@ void DisplayWindow::FindSceneRect2(RECT& sceneRect, float& scaleFactor) const
 	const HMONITOR hMonitor = MonitorFromWindow(hTaskbarWnd, MONITOR_DEFAULTTONEAREST);
 	MONITORINFO info = {sizeof(MONITORINFO)};
 
-	RECT taskBarRect, desktopRect;
+	RECT taskBarWindowRect, desktopWindowRect;
 
-	GetWindowRect(hTaskbarWnd, &taskBarRect);
+	GetWindowRect(hTaskbarWnd, &taskBarWindowRect);
 	if (GetMonitorInfo(hMonitor, &info))
 	{
-		desktopRect = info.rcMonitor;
+		desktopWindowRect = info.rcMonitor;
 	}
 	else
 	{
-		GetWindowRect(GetDesktopWindow(), &desktopRect);
+		GetWindowRect(GetDesktopWindow(), &desktopWindowRect);
 	}
 
+	const RainEngine::Rect taskBarRect = RainEngine::ToRect(taskBarWindowRect);
+	const RainEngine::Rect desktopRect = RainEngine::ToRect(desktopWindowRect);
+
 	const int top = desktopRect.top;
 	const int left = desktopRect.left;
 
@@ -781,13 +620,10 @@ void DisplayWindow::DrawRainDrops() const
 	// Draw lightning flash effect first (background layer)
 	DrawLightningFlash();
 
-	for (const auto pDrop : RainDrops)
-	{
-		pDrop->Draw(Dc.Get());
-	}
+	pSimulation->GetRainField().Draw(Dc.Get());
     
     // Draw puddles if we're in rain mode
-    if (pPuddleManager)
+    if (const auto pPuddleManager = pSimulation->GetPuddleManager())
     {
         pPuddleManager->Draw(Dc.Get());
     }
@@ -805,116 +641,24 @@ void DisplayWindow::DrawSnowFlakes() const
 	// Draw lightning flash effect first (background layer)
 	DrawLightningFlash();
 
-	for (const auto pFlake : SnowFlakes)
-	{
-		pFlake->Draw(Dc.Get());
-	}
+	pSimulation->GetSnowField().Draw(Dc.Get());
 
-	if (!SnowFlakes.empty())
+	if (!pSimulation->GetSnowField().IsEmpty())
 	{
 		// SnowFlake::DrawSettledSnow(Dc.Get(), pDisplaySpecificData);
-		SnowFlake::DrawSettledSnow2(Dc.Get(), pDisplaySpecificData);
-	}
-
-	HR(Dc->EndDraw());
-	// Make the swap chain available to the composition engine
-	HR(SwapChain->Present(1, 0));
-}
-
-void DisplayWindow::UpdateRainDrops(const float deltaTime)
-{
-	// Move each raindrop to the next point
-	for (RainDrop* const pDrop : RainDrops)
-	{
-		pDrop->UpdatePosition(deltaTime); // Use proper delta time
-	}
-
-    // Update puddles with the same time delta
-    if (pPuddleManager)
-    {
-        pPuddleManager->Update(deltaTime);
-    }
-
-	// Remove all raindrops that have expired
-	for (auto pDropIterator = RainDrops.begin(); pDropIterator != RainDrops.end();)
-	{
-		if ((*pDropIterator)->IsReadyForErase())
+		if (GeneralSettings.SnowRender == SnowRenderMode::Bitmap)
 		{
-			delete *pDropIterator;
-			pDropIterator = RainDrops.erase(pDropIterator);
+			SnowFlake::DrawSettledSnowLayer(Dc.Get(), pDisplaySpecificData);
 		}
 		else
 		{
-			++pDropIterator;
+			SnowFlake::DrawSettledSnow2(Dc.Get(), pDisplaySpecificData);
 		}
 	}
 
-	// Calculate the number of raindrops to generate
-	int countOfFallingDrops = 0;
-	for (const RainDrop* const pDrop : RainDrops)
-	{
-		if (!pDrop->DidTouchGround())
-		{
-			countOfFallingDrops++;
-		}
-	}
-
-	const int noOfDropsToGenerate = GeneralSettings.MaxParticles * 3 - countOfFallingDrops;
-
-	// Generate new raindrops
-	for (int i = 0; i < noOfDropsToGenerate; ++i)
-	{
-		RainDrop* pDrop = new RainDrop(GeneralSettings.WindSpeed, pDisplaySpecificData);
-		// Set the callback for puddle creation
-		pDrop->SetHitGroundCallback([this](const Vector2& pos) {
-			NotifyRainDropHitGround(pos);
-		});
-		RainDrops.push_back(pDrop);
-	}
-}
-
-void DisplayWindow::UpdateSnowFlakes(const float deltaTime)
-{
-	// Added 12/25/2024 - Todd D
-	// rate of snow fall *100 added
-	const int noOfFlakesToGenerate = GeneralSettings.MaxParticles * 100 - SnowFlakes.size();
-
-	if (noOfFlakesToGenerate > 0)
-	{
-		for (int i = 0; i < noOfFlakesToGenerate; i++)
-		{
-			SnowFlake* pFlake = new SnowFlake(pDisplaySpecificData);
-			SnowFlakes.push_back(pFlake);
-		}
-	}
-
-	if (noOfFlakesToGenerate < 0)
-	{
-		const int noOfFlakesToErase = -noOfFlakesToGenerate;
-		for (int i = 0; i < noOfFlakesToErase; i++)
-		{
-			delete SnowFlakes[i];
-		}
-		// Remove the first n elements
-		SnowFlakes.erase(SnowFlakes.begin(), SnowFlakes.begin() + noOfFlakesToErase);
-	}
-
-	// Get current wind direction for snow (if enabled)
-	const float snowWindFactor = GetCurrentSnowWindFactor();
-	
-	// Move each snowflake to the next point
-	for (SnowFlake* const pFlake : SnowFlakes)
-	{
-		// Apply wind to horizontal velocity if snow wind is enabled
-		if (GeneralSettings.EnableSnowWind && snowWindFactor != 0.0f)
-		{
-			// Add wind effect to the snowflake's velocity
-			pFlake->ApplyWind(snowWindFactor, deltaTime);
-		}
-		
-		pFlake->UpdatePosition(deltaTime); // Use proper delta time instead of hard-coded 0.01f
-	}
-	SnowFlake::SettleSnow(pDisplaySpecificData);
+	HR(Dc->EndDraw());
+	// Make the swap chain available to the composition engine
+	HR(SwapChain->Present(1, 0));
 }
 
 void DisplayWindow::SetInstanceToHwnd(const HWND hWnd, const LPARAM lParam)
@@ -930,74 +674,25 @@ DisplayWindow* DisplayWindow::GetInstanceFromHwnd(const HWND hWnd)
 
 DisplayWindow::~DisplayWindow()
 {
+	// The simulation references the display data, so release it first
+	pSimulation.reset();
 	delete pDisplaySpecificData;
-	// The pPuddleManager is automatically cleaned up by the unique_ptr
-}
-
-void DisplayWindow::UpdateLightning()
-{
-	// Only enable lightning during rain, not snow
-	if (GeneralSettings.PartType != RAIN)
-	{
-		LightningFlashIntensity = 0.0f;
-		LightningFlashFramesRemaining = 0;
-		return;
-	}
-
-	const double currentTime = GetCurrentTimeInSeconds();
-
-	// Initialize lightning timing on first run
-	if (NextLightningTime == 0.0)
-	{
-		// First lightning strike between 5-15 seconds, adjusted by frequency setting
-		const double frequencyMultiplier = (101 - GeneralSettings.LightningFrequency) / 100.0; // Higher setting = more frequent
-		NextLightningTime = currentTime + (5.0 + (rand() % 10)) * frequencyMultiplier;
-	}
-
-	// Check if it's time for lightning
-	if (currentTime >= NextLightningTime)
-	{
-		// Trigger lightning flash with user-configurable intensity
-		const float baseIntensity = 0.05f + (GeneralSettings.LightningIntensity / 100.0f) * 0.3f; // 0.05-0.35 range
-		LightningFlashIntensity = baseIntensity + (rand() % 5) * 0.01f; // Add small random variation
-		LightningFlashFramesRemaining = 3 + (rand() % 4); // 3-6 frames duration
-
-		// Schedule next lightning with frequency setting (5-60 seconds range)
-		const double frequencyMultiplier = (101 - GeneralSettings.LightningFrequency) / 100.0; // Higher setting = more frequent
-		const double baseInterval = 5.0 + (rand() % 25); // 5-30 seconds base
-		LastLightningTime = currentTime;
-		NextLightningTime = currentTime + baseInterval * frequencyMultiplier;
-	}
-
-	// Fade out lightning flash
-	if (LightningFlashFramesRemaining > 0)
-	{
-		LightningFlashFramesRemaining--;
-		if (LightningFlashFramesRemaining == 0)
-		{
-			LightningFlashIntensity = 0.0f;
-		}
-		else
-		{
-			// Exponential fade out
-			LightningFlashIntensity *= 0.7f;
-		}
-	}
 }
 
 void DisplayWindow::DrawLightningFlash() const
 {
-	if (LightningFlashIntensity <= 0.0f || GeneralSettings.PartType != RAIN)
+	const float lightningFlashIntensity = pSimulation->GetLightningFlashIntensity();
+	if (lightningFlashIntensity <= 0.0f || GeneralSettings.PartType != RAIN)
 	{
 		return;
 	}
 
-	// Create a semi-transparent white brush for the flash
-	const D2D1_COLOR_F flashColor = D2D1::ColorF(D2D1::ColorF::White, LightningFlashIntensity);
-	ComPtr<ID2D1SolidColorBrush> flashBrush;
-	
-	if (SUCCEEDED(Dc->CreateSolidColorBrush(flashColor, &flashBrush)))
+	// Shared white brush, faded to the flash intensity
+	ID2D1SolidColorBrush* flashBrush = pDisplaySpecificData->GetOverlayBrush();
+	if (flashBrush)
 	{
+		flashBrush->SetOpacity(lightningFlashIntensity);
+
 		// Fill the entire screen with the flash
 		const D2D1_RECT_F screenRect = D2D1::RectF(
 			static_cast<float>(pDisplaySpecificData->SceneRect.left),
@@ -1006,7 +701,7 @@ void DisplayWindow::DrawLightningFlash() const
 			static_cast<float>(pDisplaySpecificData->SceneRect.bottom)
 		);
 		
-		Dc->FillRectangle(screenRect, flashBrush.Get());
+		Dc->FillRectangle(screenRect, flashBrush);
 	}
 }
 
@@ -1039,11 +734,3 @@ void DisplayWindow::UpdateZOrder(HWND hWnd)
     }
 }
 
-void DisplayWindow::NotifyRainDropHitGround(const Vector2& position)
-{
-    // Only proceed if we have a valid puddle manager
-    if (pPuddleManager)
-    {
-        pPuddleManager->CreateOrAddToPuddle(position);
-    }
-}
@@ -8,12 +8,10 @@
 #include <vector>
 
 #include "framework.h"
-#include "RainDrop.h"
 #include "CallBackWindow.h"
 #include "OptionDialog.h"
 #include "SettingsManager.h"
-#include "SnowFlake.h"
-#include "Puddle.h"  // Include the new Puddle header
+#include "WeatherSimulation.h"
 
 // https://docs.microsoft.com/en-us/archive/msdn-magazine/2014/june/windows-with-c-high-performance-window-layering-using-the-windows-composition-engine
 
@@ -37,7 +35,8 @@ class DisplayWindow final : CallBackWindow
 {
 public:
 	HRESULT Initialize(HINSTANCE hInstance, const MonitorData& monitorData);
-	void Animate();
+	// Run this frame's steps of the shared clock and draw the result
+	void Animate(const RainEngine::SimulationClock& clock);
 
 	// CallBackWindow Overrides
 	void UpdateParticleCount(int val) override;
@@ -71,26 +70,8 @@ private:
 	static HINSTANCE AppInstance;
 	static OptionsDialog* pOptionsDlg;
 
-	std::vector<RainDrop*> RainDrops;
-	std::vector<SnowFlake*> SnowFlakes;
-	std::unique_ptr<PuddleManager> pPuddleManager;  // Added puddle manager
-
-	// For animation
-	double CurrentTime = -1.0;
-	double Accumulator = 0.0;
-
-	// Lightning flash system
-	double LastLightningTime = 0.0;
-	double NextLightningTime = 0.0;
-	float LightningFlashIntensity = 0.0f;
-	int LightningFlashFramesRemaining = 0;
-
-	// Snow wind system
-	double LastWindChangeTime = 0.0;
-	double NextWindChangeTime = 0.0;
-	float CurrentSnowWindDirection = 0.0f;
-	float TargetSnowWindDirection = 0.0f;
-	float WindTransitionProgress = 1.0f;
+	// Platform-neutral particle, puddle, lightning and wind state for this display
+	std::unique_ptr<RainEngine::WeatherSimulation> pSimulation;
 
 	static Setting GeneralSettings;
 
@@ -108,30 +89,19 @@ private:
 
 	void HandleWindowBoundsChange(HWND window, bool clearDrops);
 	void HandleTaskBarChange() const;
-	void FindSceneRect2(RECT& sceneRect, float& scaleFactor) const;
-	void FindSceneRect(RECT& sceneRect, float& scaleFactor) const;
+	void FindSceneRect2(RainEngine::Rect& sceneRect, float& scaleFactor) const;
+	void FindSceneRect(RainEngine::Rect& sceneRect, float& scaleFactor) const;
 
 	static void InitNotifyIcon(HWND hWnd);
 	static void RemoveNotifyIcon(HWND hWnd);
 	static void ShowContextMenu(HWND hWnd);
 
-	static double GetCurrentTimeInSeconds();
-	void UpdateRainDrops(float deltaTime);
-	void UpdateSnowFlakes(float deltaTime);
 	void DrawRainDrops() const;
 	void DrawSnowFlakes() const;
 
 	// Lightning flash methods
-	void UpdateLightning();
 	void DrawLightningFlash() const;
 
-	// Snow wind methods
-	void UpdateSnowWind(float deltaTime);
-	float GetCurrentSnowWindFactor() const;
-
-	// Puddle notifications
-	void NotifyRainDropHitGround(const Vector2& position); // Method to inform puddle system about raindrops
-
 	static void SetInstanceToHwnd(HWND hWnd, LPARAM lParam);
 	static DisplayWindow* GetInstanceFromHwnd(HWND hWnd);
 
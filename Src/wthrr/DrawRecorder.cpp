@@ -0,0 +1,55 @@
+#include "DrawRecorder.h"
+
+#include <d2d1.h>
+
+#include "DisplayData.h"
+#include "Win32Interop.h"
+
+namespace RainEngine {
+
+namespace {
+constexpr float DEGREES_PER_RADIAN = 180.0f / 3.14159265359f;
+}
+
+void DrawRecorder::Replay(ID2D1DeviceContext* dc, const DisplayData& display) const
+{
+    for (const Command& command : commands_)
+    {
+        ID2D1SolidColorBrush* brush = command.Opacity >= 1.0f ? display.DropColorBrush.Get()
+                                                              : display.GetDropOpacityBrush(command.Opacity);
+        switch (command.Type)
+        {
+        case Kind::Line:
+            dc->DrawLine(ToD2DPoint(command.A), ToD2DPoint(command.B), brush, command.Size);
+            break;
+        case Kind::FillEllipse:
+        {
+            const D2D1_ELLIPSE ellipse = D2D1::Ellipse(ToD2DPoint(command.A), command.B.x, command.B.y);
+            if (command.Rotation == 0.0f)
+            {
+                dc->FillEllipse(ellipse, brush);
+                break;
+            }
+
+            // Turned about its centre for this one shape
+            D2D1::Matrix3x2F originalTransform;
+            dc->GetTransform(&originalTransform);
+            dc->SetTransform(D2D1::Matrix3x2F::Rotation(command.Rotation * DEGREES_PER_RADIAN,
+                                                        ToD2DPoint(command.A)) * originalTransform);
+            dc->FillEllipse(ellipse, brush);
+            dc->SetTransform(originalTransform);
+            break;
+        }
+        case Kind::StrokeEllipse:
+            dc->DrawEllipse(D2D1::Ellipse(ToD2DPoint(command.A), command.B.x, command.B.y), brush, command.Size);
+            break;
+        case Kind::FillRect:
+            dc->FillRectangle(D2D1::RectF(command.A.x, command.A.y, command.B.x, command.B.y), brush);
+            break;
+        case Kind::Bitmap:
+            break;
+        }
+    }
+}
+
+} // namespace RainEngine
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "CoreTypes.h"
+
+// Forward declaration to keep Direct2D out of the simulation core
+struct ID2D1DeviceContext;
+
+namespace RainEngine {
+
+class DisplayData;
+
+// The draw calls of a frame, as data.
+//
+// Each simulation type's Record walks its state once and makes every
+// visibility, clipping and fade decision, handing the resulting primitives
+// to a recorder. On Windows, Draw records into the display's recorder and
+// Replay issues the Direct2D calls, so what is drawn and what a headless
+// host counts come from the same code. Hosts without Direct2D only record,
+// to time a full frame and to count what it would draw. Commands are kept
+// in one reused array, so a steady frame does not allocate.
+class DrawRecorder {
+public:
+    enum class Kind : std::uint8_t {
+        Line,          // A to B, Size is the stroke width
+        FillEllipse,   // Centre A, radii B, turned Rotation radians about A
+        StrokeEllipse, // Centre A, radii B, Size is the stroke width
+        FillRect,      // Corners A and B
+        Bitmap         // Settled snow layer stretched over corners A and B; drawn by SnowLayerBitmap
+    };
+
+    // Every primitive is in the drop colour at Opacity
+    struct Command {
+        Kind Type = Kind::Line;
+        PointF A;
+        PointF B;
+        float Size = 0.0f;
+        float Opacity = 1.0f;
+        float Rotation = 0.0f;
+    };
+
+    void Clear() noexcept { commands_.clear(); }
+
+    void Line(const PointF start, const PointF end, const float width, const float opacity = 1.0f) {
+        commands_.push_back({Kind::Line, start, end, width, opacity});
+    }
+    void FillEllipse(const PointF center, const float radiusX, const float radiusY, const float opacity = 1.0f,
+                     const float rotation = 0.0f) {
+        commands_.push_back({Kind::FillEllipse, center, {radiusX, radiusY}, 0.0f, opacity, rotation});
+    }
+    void StrokeEllipse(const PointF center, const float radiusX, const float radiusY, const float width,
+                       const float opacity = 1.0f) {
+        commands_.push_back({Kind::StrokeEllipse, center, {radiusX, radiusY}, width, opacity});
+    }
+    void FillRect(const PointF topLeft, const PointF bottomRight, const float opacity = 1.0f) {
+        commands_.push_back({Kind::FillRect, topLeft, bottomRight, 0.0f, opacity});
+    }
+    void FillRect(const Rect& rect, const float opacity = 1.0f) {
+        FillRect({static_cast<float>(rect.left), static_cast<float>(rect.top)},
+                 {static_cast<float>(rect.right), static_cast<float>(rect.bottom)}, opacity);
+    }
+    void Bitmap(const Rect& dest) {
+        commands_.push_back({Kind::Bitmap,
+                             {static_cast<float>(dest.left), static_cast<float>(dest.top)},
+                             {static_cast<float>(dest.right), static_cast<float>(dest.bottom)}});
+    }
+
+    [[nodiscard]] const std::vector<Command>& GetCommands() const noexcept { return commands_; }
+    [[nodiscard]] size_t Size() const noexcept { return commands_.size(); }
+
+    // Bytes reserved for commands
+    [[nodiscard]] size_t GetMemoryUsage() const noexcept { return commands_.capacity() * sizeof(Command); }
+
+    // Issue every command on dc with the display's drop colour brushes.
+    // Bitmap commands are skipped; SnowLayerBitmap::Draw owns the GPU bitmap.
+    void Replay(ID2D1DeviceContext* dc, const DisplayData& display) const;
+
+private:
+    std::vector<Command> commands_;
+};
+
+} // namespace RainEngine
@@ -64,7 +64,7 @@ public:
     [[nodiscard]] ErrorCode GetErrorCode() const noexcept { return errorCode; }
     [[nodiscard]] const std::string& GetMessage() const noexcept { 
         static const std::string empty;
-        return message.value_or(empty); 
+        return message ? *message : empty; 
     }
     
     #ifdef __cpp_lib_source_location
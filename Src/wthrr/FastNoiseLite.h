@@ -51,6 +51,7 @@
 #define FASTNOISELITE_H
 
 #include <cmath>
+#include <cstddef>
 
 class FastNoiseLite
 {
@@ -338,6 +339,24 @@ public:
         }
     }
 
+    /// <summary>
+    /// 2D noise at count positions using current settings
+    /// </summary>
+    /// <remarks>
+    /// out[i] is bit for bit GetNoise(xs[i], ys[i]) for finite positions.
+    /// Defined in FastNoiseLiteBatch.cpp: plain OpenSimplex2 runs on SSE2 or
+    /// AVX2 where available, everything else loops over GetNoise
+    /// </remarks>
+    void GetNoiseBatch(const float* xs, const float* ys, float* out, size_t count) const;
+
+    /// <summary>
+    /// 3D noise at count positions using current settings
+    /// </summary>
+    /// <remarks>
+    /// out[i] is bit for bit GetNoise(xs[i], ys[i], zs[i]) for finite positions
+    /// </remarks>
+    void GetNoiseBatch(const float* xs, const float* ys, const float* zs, float* out, size_t count) const;
+
 
     /// <summary>
     /// 2D warps the input position using current domain warp settings
@@ -0,0 +1,139 @@
+#include "FastNoiseLite.h"
+#include "FastNoiseLiteBatch.h"
+#include "FastNoiseLiteBatchKernels.h"
+
+#include <atomic>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace RainEngine {
+namespace NoiseBatch {
+
+namespace {
+
+std::atomic<SimdLevel> g_simdLimit{SimdLevel::Avx2};
+
+[[nodiscard]] bool CpuHasAvx2() noexcept
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int info[4];
+    __cpuid(info, 1);
+    const bool osSavesAvx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+    if (!osSavesAvx) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+[[nodiscard]] SimdLevel DetectSimdLevel() noexcept
+{
+    if (HasAvx2Kernels() && CpuHasAvx2()) return SimdLevel::Avx2;
+#ifdef WTHRR_NOISE_SSE2
+    return SimdLevel::Sse2;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+} // namespace
+
+SimdLevel GetSimdLevel() noexcept
+{
+    static const SimdLevel detected = DetectSimdLevel();
+    const SimdLevel limit = g_simdLimit.load(std::memory_order_relaxed);
+    return static_cast<int>(limit) < static_cast<int>(detected) ? limit : detected;
+}
+
+void SetSimdLimit(const SimdLevel limit) noexcept
+{
+    g_simdLimit.store(limit, std::memory_order_relaxed);
+}
+
+#ifdef WTHRR_NOISE_SSE2
+size_t OpenSimplex2Sse2(const Params& params, const float* xs, const float* ys, float* out, const size_t count) noexcept
+{
+    return OpenSimplex2<Sse2>(params, xs, ys, out, count);
+}
+
+size_t OpenSimplex2Sse2(const Params& params, const float* xs, const float* ys, const float* zs, float* out,
+                        const size_t count) noexcept
+{
+    return OpenSimplex2<Sse2>(params, xs, ys, zs, out, count);
+}
+#else
+size_t OpenSimplex2Sse2(const Params&, const float*, const float*, float*, size_t) noexcept
+{
+    return 0;
+}
+
+size_t OpenSimplex2Sse2(const Params&, const float*, const float*, const float*, float*, size_t) noexcept
+{
+    return 0;
+}
+#endif
+
+} // namespace NoiseBatch
+} // namespace RainEngine
+
+void FastNoiseLite::GetNoiseBatch(const float* xs, const float* ys, float* out, const size_t count) const
+{
+    using namespace RainEngine::NoiseBatch;
+
+    size_t done = 0;
+    if (mNoiseType == NoiseType_OpenSimplex2 && mFractalType == FractalType_None)
+    {
+        const Params params{mSeed, mFrequency, Lookup<float>::Gradients2D};
+        switch (GetSimdLevel())
+        {
+        case SimdLevel::Avx2:
+            done = OpenSimplex2Avx2(params, xs, ys, out, count);
+            break;
+        case SimdLevel::Sse2:
+            done = OpenSimplex2Sse2(params, xs, ys, out, count);
+            break;
+        default:
+            break;
+        }
+    }
+
+    // Other settings, and the positions short of a whole vector
+    for (size_t i = done; i < count; i++)
+    {
+        out[i] = GetNoise(xs[i], ys[i]);
+    }
+}
+
+void FastNoiseLite::GetNoiseBatch(const float* xs, const float* ys, const float* zs, float* out,
+                                  const size_t count) const
+{
+    using namespace RainEngine::NoiseBatch;
+
+    size_t done = 0;
+    if (mNoiseType == NoiseType_OpenSimplex2 && mFractalType == FractalType_None &&
+        mTransformType3D == TransformType3D_DefaultOpenSimplex2)
+    {
+        const Params params{mSeed, mFrequency, Lookup<float>::Gradients3D};
+        switch (GetSimdLevel())
+        {
+        case SimdLevel::Avx2:
+            done = OpenSimplex2Avx2(params, xs, ys, zs, out, count);
+            break;
+        case SimdLevel::Sse2:
+            done = OpenSimplex2Sse2(params, xs, ys, zs, out, count);
+            break;
+        default:
+            break;
+        }
+    }
+
+    for (size_t i = done; i < count; i++)
+    {
+        out[i] = GetNoise(xs[i], ys[i], zs[i]);
+    }
+}
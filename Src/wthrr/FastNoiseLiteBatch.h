@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+
+namespace RainEngine {
+
+// Vector back ends of FastNoiseLite::GetNoiseBatch.
+//
+// The kernels evaluate plain OpenSimplex2 (no fractal, default 3D rotation)
+// for a whole number of vector widths, repeating the scalar code operation
+// by operation so every result is bit for bit what GetNoise returns. Each
+// returns how many positions it wrote; the caller finishes the rest with
+// GetNoise. The AVX2 kernels live in their own translation unit built for
+// AVX2 and only run once the CPU has been checked for it.
+namespace NoiseBatch {
+
+enum class SimdLevel {
+    Scalar,
+    Sse2,
+    Avx2
+};
+
+// Settings of the noise object the kernels need
+struct Params {
+    int Seed;
+    float Frequency;
+    const float* Gradients; // FastNoiseLite's 2D or 3D gradient table
+};
+
+// Widest level this build and CPU can run, capped by SetSimdLimit
+[[nodiscard]] SimdLevel GetSimdLevel() noexcept;
+
+// Cap the level GetNoiseBatch uses, so tests and benchmarks can compare them
+void SetSimdLimit(SimdLevel limit) noexcept;
+
+size_t OpenSimplex2Sse2(const Params& params, const float* xs, const float* ys, float* out, size_t count) noexcept;
+size_t OpenSimplex2Sse2(const Params& params, const float* xs, const float* ys, const float* zs, float* out,
+                        size_t count) noexcept;
+
+// Whether FastNoiseLiteBatchAvx2.cpp was built with AVX2 enabled
+[[nodiscard]] bool HasAvx2Kernels() noexcept;
+size_t OpenSimplex2Avx2(const Params& params, const float* xs, const float* ys, float* out, size_t count) noexcept;
+size_t OpenSimplex2Avx2(const Params& params, const float* xs, const float* ys, const float* zs, float* out,
+                        size_t count) noexcept;
+
+} // namespace NoiseBatch
+
+} // namespace RainEngine
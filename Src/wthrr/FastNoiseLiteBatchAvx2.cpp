@@ -0,0 +1,45 @@
+// Built with AVX2 enabled (-mavx2, /arch:AVX2); FastNoiseLiteBatch.cpp only
+// calls in here after checking the CPU. Include nothing with inline functions
+// of external linkage, or the linker may keep this file's AVX2 copy of them.
+#include "FastNoiseLiteBatch.h"
+#include "FastNoiseLiteBatchKernels.h"
+
+namespace RainEngine {
+namespace NoiseBatch {
+
+#ifdef WTHRR_NOISE_AVX2
+bool HasAvx2Kernels() noexcept
+{
+    return true;
+}
+
+size_t OpenSimplex2Avx2(const Params& params, const float* xs, const float* ys, float* out, const size_t count) noexcept
+{
+    return OpenSimplex2<Avx2>(params, xs, ys, out, count);
+}
+
+size_t OpenSimplex2Avx2(const Params& params, const float* xs, const float* ys, const float* zs, float* out,
+                        const size_t count) noexcept
+{
+    return OpenSimplex2<Avx2>(params, xs, ys, zs, out, count);
+}
+#else
+// Built without AVX2 (not an x86 target, or the flag was left off)
+bool HasAvx2Kernels() noexcept
+{
+    return false;
+}
+
+size_t OpenSimplex2Avx2(const Params&, const float*, const float*, float*, size_t) noexcept
+{
+    return 0;
+}
+
+size_t OpenSimplex2Avx2(const Params&, const float*, const float*, const float*, float*, size_t) noexcept
+{
+    return 0;
+}
+#endif
+
+} // namespace NoiseBatch
+} // namespace RainEngine
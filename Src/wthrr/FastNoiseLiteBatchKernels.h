@@ -0,0 +1,359 @@
+#pragma once
+
+// OpenSimplex2 kernels shared by the SSE2 and AVX2 translation units.
+//
+// Each kernel is written once against a small set of vector operations and
+// instantiated per instruction set. Every scalar branch of FastNoiseLite is
+// turned into a select, with the operations kept in the scalar order, so a
+// lane computes exactly the float the scalar code would. Everything here has
+// internal linkage, so the AVX2 build of it can never stand in for the SSE2
+// one at link time.
+
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define WTHRR_NOISE_SSE2 1
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#define WTHRR_NOISE_AVX2 1
+#include <immintrin.h>
+#endif
+
+#include "FastNoiseLiteBatch.h"
+
+namespace RainEngine {
+namespace NoiseBatch {
+namespace {
+
+// Hashing primes of FastNoiseLite
+constexpr int PRIME_X = 501125321;
+constexpr int PRIME_Y = 1136930381;
+constexpr int PRIME_Z = 1720413743;
+constexpr int HASH_MULTIPLIER = 0x27d4eb2d;
+
+#ifdef WTHRR_NOISE_SSE2
+struct Sse2 {
+    static constexpr size_t WIDTH = 4;
+    using F = __m128;
+    using I = __m128i;
+
+    static F Load(const float* p) noexcept { return _mm_loadu_ps(p); }
+    static void Store(float* p, F v) noexcept { _mm_storeu_ps(p, v); }
+    static F Set(float v) noexcept { return _mm_set1_ps(v); }
+    static I SetI(int v) noexcept { return _mm_set1_epi32(v); }
+
+    static F Add(F a, F b) noexcept { return _mm_add_ps(a, b); }
+    static F Sub(F a, F b) noexcept { return _mm_sub_ps(a, b); }
+    static F Mul(F a, F b) noexcept { return _mm_mul_ps(a, b); }
+    static F Neg(F a) noexcept { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+
+    static F Gt(F a, F b) noexcept { return _mm_cmpgt_ps(a, b); }
+    static F Ge(F a, F b) noexcept { return _mm_cmpge_ps(a, b); }
+    static F And(F a, F b) noexcept { return _mm_and_ps(a, b); }
+    static F Or(F a, F b) noexcept { return _mm_or_ps(a, b); }
+    static F AndNot(F a, F b) noexcept { return _mm_andnot_ps(a, b); } // ~a & b
+    static F Select(F mask, F a, F b) noexcept { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+    static I SelectI(F mask, I a, I b) noexcept {
+        const I m = _mm_castps_si128(mask);
+        return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b));
+    }
+    static I MaskI(F mask) noexcept { return _mm_castps_si128(mask); }
+
+    static I AddI(I a, I b) noexcept { return _mm_add_epi32(a, b); }
+    static I SubI(I a, I b) noexcept { return _mm_sub_epi32(a, b); }
+    static I AndI(I a, I b) noexcept { return _mm_and_si128(a, b); }
+    static I OrI(I a, I b) noexcept { return _mm_or_si128(a, b); }
+    static I XorI(I a, I b) noexcept { return _mm_xor_si128(a, b); }
+    static I NotI(I a) noexcept { return _mm_xor_si128(a, _mm_set1_epi32(-1)); }
+    template <int N>
+    static I ShiftRightI(I a) noexcept { return _mm_srai_epi32(a, N); }
+
+    // SSE2 has no 32-bit low multiply; build it from the two 32x32->64 products
+    static I MulI(I a, I b) noexcept {
+        const I even = _mm_mul_epu32(a, b);
+        const I odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+        return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                                  _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+    }
+
+    static I Truncate(F v) noexcept { return _mm_cvttps_epi32(v); }
+    static F ToFloat(I v) noexcept { return _mm_cvtepi32_ps(v); }
+
+    static F Gather(const float* table, I index) noexcept {
+        alignas(16) int lanes[WIDTH];
+        _mm_store_si128(reinterpret_cast<I*>(lanes), index);
+        return _mm_setr_ps(table[lanes[0]], table[lanes[1]], table[lanes[2]], table[lanes[3]]);
+    }
+};
+#endif
+
+#ifdef WTHRR_NOISE_AVX2
+struct Avx2 {
+    static constexpr size_t WIDTH = 8;
+    using F = __m256;
+    using I = __m256i;
+
+    static F Load(const float* p) noexcept { return _mm256_loadu_ps(p); }
+    static void Store(float* p, F v) noexcept { _mm256_storeu_ps(p, v); }
+    static F Set(float v) noexcept { return _mm256_set1_ps(v); }
+    static I SetI(int v) noexcept { return _mm256_set1_epi32(v); }
+
+    static F Add(F a, F b) noexcept { return _mm256_add_ps(a, b); }
+    static F Sub(F a, F b) noexcept { return _mm256_sub_ps(a, b); }
+    static F Mul(F a, F b) noexcept { return _mm256_mul_ps(a, b); }
+    static F Neg(F a) noexcept { return _mm256_xor_ps(a, _mm256_set1_ps(-0.0f)); }
+
+    static F Gt(F a, F b) noexcept { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static F Ge(F a, F b) noexcept { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    static F And(F a, F b) noexcept { return _mm256_and_ps(a, b); }
+    static F Or(F a, F b) noexcept { return _mm256_or_ps(a, b); }
+    static F AndNot(F a, F b) noexcept { return _mm256_andnot_ps(a, b); } // ~a & b
+    static F Select(F mask, F a, F b) noexcept { return _mm256_blendv_ps(b, a, mask); }
+    static I SelectI(F mask, I a, I b) noexcept {
+        return _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(b), _mm256_castsi256_ps(a), mask));
+    }
+    static I MaskI(F mask) noexcept { return _mm256_castps_si256(mask); }
+
+    static I AddI(I a, I b) noexcept { return _mm256_add_epi32(a, b); }
+    static I SubI(I a, I b) noexcept { return _mm256_sub_epi32(a, b); }
+    static I AndI(I a, I b) noexcept { return _mm256_and_si256(a, b); }
+    static I OrI(I a, I b) noexcept { return _mm256_or_si256(a, b); }
+    static I XorI(I a, I b) noexcept { return _mm256_xor_si256(a, b); }
+    static I NotI(I a) noexcept { return _mm256_xor_si256(a, _mm256_set1_epi32(-1)); }
+    template <int N>
+    static I ShiftRightI(I a) noexcept { return _mm256_srai_epi32(a, N); }
+    static I MulI(I a, I b) noexcept { return _mm256_mullo_epi32(a, b); }
+
+    static I Truncate(F v) noexcept { return _mm256_cvttps_epi32(v); }
+    static F ToFloat(I v) noexcept { return _mm256_cvtepi32_ps(v); }
+
+    static F Gather(const float* table, I index) noexcept { return _mm256_i32gather_ps(table, index, 4); }
+};
+#endif
+
+// FastFloor: f >= 0 ? (int)f : (int)f - 1
+template <typename V>
+typename V::I Floor(typename V::F f) noexcept {
+    const typename V::I notPositive = V::NotI(V::MaskI(V::Ge(f, V::Set(0.0f))));
+    return V::AddI(V::Truncate(f), notPositive); // The mask is -1 where f < 0
+}
+
+// FastRound: f >= 0 ? (int)(f + 0.5f) : (int)(f - 0.5f)
+template <typename V>
+typename V::I Round(typename V::F f) noexcept {
+    const typename V::F positive = V::Ge(f, V::Set(0.0f));
+    return V::Truncate(V::Select(positive, V::Add(f, V::Set(0.5f)), V::Sub(f, V::Set(0.5f))));
+}
+
+// GradCoord with the primed lattice coordinates already combined with the seed
+template <typename V>
+typename V::F Grad(const float* gradients, typename V::I hash, const typename V::F xd, const typename V::F yd) noexcept {
+    hash = V::MulI(hash, V::SetI(HASH_MULTIPLIER));
+    hash = V::XorI(hash, V::template ShiftRightI<15>(hash));
+    hash = V::AndI(hash, V::SetI(127 << 1));
+    const typename V::F xg = V::Gather(gradients, hash);
+    const typename V::F yg = V::Gather(gradients, V::OrI(hash, V::SetI(1)));
+    return V::Add(V::Mul(xd, xg), V::Mul(yd, yg));
+}
+
+template <typename V>
+typename V::F Grad(const float* gradients, typename V::I hash, const typename V::F xd, const typename V::F yd,
+                   const typename V::F zd) noexcept {
+    hash = V::MulI(hash, V::SetI(HASH_MULTIPLIER));
+    hash = V::XorI(hash, V::template ShiftRightI<15>(hash));
+    hash = V::AndI(hash, V::SetI(63 << 2));
+    const typename V::F xg = V::Gather(gradients, hash);
+    const typename V::F yg = V::Gather(gradients, V::OrI(hash, V::SetI(1)));
+    const typename V::F zg = V::Gather(gradients, V::OrI(hash, V::SetI(2)));
+    return V::Add(V::Add(V::Mul(xd, xg), V::Mul(yd, yg)), V::Mul(zd, zg));
+}
+
+// (a * a) * (a * a) * gradient where a > 0, else 0
+template <typename V>
+typename V::F Contribution(const typename V::F a, const typename V::F gradient) noexcept {
+    const typename V::F a2 = V::Mul(a, a);
+    const typename V::F zero = V::Set(0.0f);
+    return V::Select(V::Gt(a, zero), V::Mul(V::Mul(a2, a2), gradient), zero);
+}
+
+// GetNoise(x, y) for OpenSimplex2: TransformNoiseCoordinate, then SingleSimplex
+template <typename V>
+size_t OpenSimplex2(const Params& params, const float* xs, const float* ys, float* out, const size_t count) noexcept
+{
+    using F = typename V::F;
+    using I = typename V::I;
+
+    // Constants as the scalar code spells them, so they round the same way
+    constexpr float SKEW_SQRT3 = static_cast<float>(1.7320508075688772935274463415059);
+    constexpr float F2 = 0.5f * (SKEW_SQRT3 - 1);
+    constexpr float SQRT3 = 1.7320508075688772935274463415059f;
+    constexpr float G2 = (3 - SQRT3) / 6;
+    constexpr float C_T = static_cast<float>(2 * (1 - 2 * G2) * (1 / G2 - 2));
+    constexpr float C_A = static_cast<float>(-2 * (1 - 2 * G2) * (1 - 2 * G2));
+
+    const F frequency = V::Set(params.Frequency);
+    const I seed = V::SetI(params.Seed);
+    const I primeX = V::SetI(PRIME_X);
+    const I primeY = V::SetI(PRIME_Y);
+    const size_t end = count - count % V::WIDTH;
+
+    for (size_t n = 0; n < end; n += V::WIDTH)
+    {
+        F x = V::Mul(V::Load(xs + n), frequency);
+        F y = V::Mul(V::Load(ys + n), frequency);
+        const F skew = V::Mul(V::Add(x, y), V::Set(F2));
+        x = V::Add(x, skew);
+        y = V::Add(y, skew);
+
+        I i = Floor<V>(x);
+        I j = Floor<V>(y);
+        const F xi = V::Sub(x, V::ToFloat(i));
+        const F yi = V::Sub(y, V::ToFloat(j));
+
+        const F t = V::Mul(V::Add(xi, yi), V::Set(G2));
+        const F x0 = V::Sub(xi, t);
+        const F y0 = V::Sub(yi, t);
+
+        i = V::MulI(i, primeX);
+        j = V::MulI(j, primeY);
+
+        const F a = V::Sub(V::Sub(V::Set(0.5f), V::Mul(x0, x0)), V::Mul(y0, y0));
+        const F n0 = Contribution<V>(a, Grad<V>(params.Gradients, V::XorI(V::XorI(seed, i), j), x0, y0));
+
+        const F c = V::Add(V::Mul(V::Set(C_T), t), V::Add(V::Set(C_A), a));
+        const F x2 = V::Add(x0, V::Set(2 * G2 - 1));
+        const F y2 = V::Add(y0, V::Set(2 * G2 - 1));
+        const I i2 = V::AddI(i, primeX);
+        const I j2 = V::AddI(j, primeY);
+        const F n2 = Contribution<V>(c, Grad<V>(params.Gradients, V::XorI(V::XorI(seed, i2), j2), x2, y2));
+
+        // The middle corner is above or right of the first, by which half of the cell we are in
+        const F upper = V::Gt(y0, x0);
+        const F x1 = V::Add(x0, V::Select(upper, V::Set(G2), V::Set(G2 - 1)));
+        const F y1 = V::Add(y0, V::Select(upper, V::Set(G2 - 1), V::Set(G2)));
+        const I i1 = V::SelectI(upper, i, i2);
+        const I j1 = V::SelectI(upper, j2, j);
+        const F b = V::Sub(V::Sub(V::Set(0.5f), V::Mul(x1, x1)), V::Mul(y1, y1));
+        const F n1 = Contribution<V>(b, Grad<V>(params.Gradients, V::XorI(V::XorI(seed, i1), j1), x1, y1));
+
+        V::Store(out + n, V::Mul(V::Add(V::Add(n0, n1), n2), V::Set(99.83685446303647f)));
+    }
+    return end;
+}
+
+// GetNoise(x, y, z) for OpenSimplex2: the default rotation, then SingleOpenSimplex2
+template <typename V>
+size_t OpenSimplex2(const Params& params, const float* xs, const float* ys, const float* zs, float* out,
+                    const size_t count) noexcept
+{
+    using F = typename V::F;
+    using I = typename V::I;
+
+    constexpr float R3 = static_cast<float>(2.0 / 3.0);
+
+    const F frequency = V::Set(params.Frequency);
+    const I primeX = V::SetI(PRIME_X);
+    const I primeY = V::SetI(PRIME_Y);
+    const I primeZ = V::SetI(PRIME_Z);
+    const I one = V::SetI(1);
+    const size_t end = count - count % V::WIDTH;
+
+    for (size_t n = 0; n < end; n += V::WIDTH)
+    {
+        F x = V::Mul(V::Load(xs + n), frequency);
+        F y = V::Mul(V::Load(ys + n), frequency);
+        F z = V::Mul(V::Load(zs + n), frequency);
+        const F r = V::Mul(V::Add(V::Add(x, y), z), V::Set(R3)); // Rotation, not skew
+        x = V::Sub(r, x);
+        y = V::Sub(r, y);
+        z = V::Sub(r, z);
+
+        I i = Round<V>(x);
+        I j = Round<V>(y);
+        I k = Round<V>(z);
+        F x0 = V::Sub(x, V::ToFloat(i));
+        F y0 = V::Sub(y, V::ToFloat(j));
+        F z0 = V::Sub(z, V::ToFloat(k));
+
+        I xNSign = V::OrI(V::Truncate(V::Sub(V::Set(-1.0f), x0)), one);
+        I yNSign = V::OrI(V::Truncate(V::Sub(V::Set(-1.0f), y0)), one);
+        I zNSign = V::OrI(V::Truncate(V::Sub(V::Set(-1.0f), z0)), one);
+
+        F ax0 = V::Mul(V::ToFloat(xNSign), V::Neg(x0));
+        F ay0 = V::Mul(V::ToFloat(yNSign), V::Neg(y0));
+        F az0 = V::Mul(V::ToFloat(zNSign), V::Neg(z0));
+
+        i = V::MulI(i, primeX);
+        j = V::MulI(j, primeY);
+        k = V::MulI(k, primeZ);
+
+        F value = V::Set(0.0f);
+        F a = V::Sub(V::Sub(V::Set(0.6f), V::Mul(x0, x0)), V::Add(V::Mul(y0, y0), V::Mul(z0, z0)));
+        int seed = params.Seed;
+
+        for (int l = 0; ; l++)
+        {
+            const I seedLanes = V::SetI(seed);
+            value = V::Add(value, Contribution<V>(a, Grad<V>(params.Gradients,
+                                                             V::XorI(V::XorI(V::XorI(seedLanes, i), j), k),
+                                                             x0, y0, z0)));
+
+            // Step towards the second corner along the axis the point is furthest along
+            const F alongX = V::And(V::Ge(ax0, ay0), V::Ge(ax0, az0));
+            const F alongY = V::AndNot(alongX, V::And(V::Gt(ay0, ax0), V::Ge(ay0, az0)));
+            const F xSign = V::ToFloat(xNSign);
+            const F ySign = V::ToFloat(yNSign);
+            const F zSign = V::ToFloat(zNSign);
+            const F movedX = V::Add(x0, xSign);
+            const F movedY = V::Add(y0, ySign);
+            const F movedZ = V::Add(z0, zSign);
+            const F b0 = V::Add(a, V::Set(1.0f));
+            const F bX = V::Sub(b0, V::Mul(V::ToFloat(V::AddI(xNSign, xNSign)), movedX));
+            const F bY = V::Sub(b0, V::Mul(V::ToFloat(V::AddI(yNSign, yNSign)), movedY));
+            const F bZ = V::Sub(b0, V::Mul(V::ToFloat(V::AddI(zNSign, zNSign)), movedZ));
+            const F alongXOrY = V::Or(alongX, alongY);
+
+            const F x1 = V::Select(alongX, movedX, x0);
+            const F y1 = V::Select(alongY, movedY, y0);
+            const F z1 = V::Select(alongXOrY, z0, movedZ);
+            const F b = V::Select(alongX, bX, V::Select(alongY, bY, bZ));
+            const I i1 = V::SelectI(alongX, V::SubI(i, V::MulI(xNSign, primeX)), i);
+            const I j1 = V::SelectI(alongY, V::SubI(j, V::MulI(yNSign, primeY)), j);
+            const I k1 = V::SelectI(alongXOrY, k, V::SubI(k, V::MulI(zNSign, primeZ)));
+
+            value = V::Add(value, Contribution<V>(b, Grad<V>(params.Gradients,
+                                                             V::XorI(V::XorI(V::XorI(seedLanes, i1), j1), k1),
+                                                             x1, y1, z1)));
+
+            if (l == 1) break;
+
+            ax0 = V::Sub(V::Set(0.5f), ax0);
+            ay0 = V::Sub(V::Set(0.5f), ay0);
+            az0 = V::Sub(V::Set(0.5f), az0);
+
+            x0 = V::Mul(xSign, ax0);
+            y0 = V::Mul(ySign, ay0);
+            z0 = V::Mul(zSign, az0);
+
+            a = V::Add(a, V::Sub(V::Sub(V::Set(0.75f), ax0), V::Add(ay0, az0)));
+
+            i = V::AddI(i, V::AndI(V::template ShiftRightI<1>(xNSign), primeX));
+            j = V::AddI(j, V::AndI(V::template ShiftRightI<1>(yNSign), primeY));
+            k = V::AddI(k, V::AndI(V::template ShiftRightI<1>(zNSign), primeZ));
+
+            xNSign = V::SubI(V::SetI(0), xNSign);
+            yNSign = V::SubI(V::SetI(0), yNSign);
+            zNSign = V::SubI(V::SetI(0), zNSign);
+
+            seed = ~seed;
+        }
+
+        V::Store(out + n, V::Mul(value, V::Set(32.69428253173828125f)));
+    }
+    return end;
+}
+
+} // namespace
+} // namespace NoiseBatch
+} // namespace RainEngine
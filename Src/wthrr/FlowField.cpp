@@ -0,0 +1,121 @@
+#include "FlowField.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "FastNoiseLite.h"
+
+namespace RainEngine {
+
+void FlowField::Configure(const float left, const float top, const int width, const int height,
+                          const int cellSize, const float spatialScale, const float sliceInterval)
+{
+    left_ = left;
+    top_ = top;
+    width_ = std::max(width, 1);
+    height_ = std::max(height, 1);
+    cellSize_ = std::max(cellSize, 1);
+    invCellSize_ = 1.0f / static_cast<float>(cellSize_);
+    spatialScale_ = spatialScale;
+    sliceInterval_ = sliceInterval;
+
+    // One sample past each far edge, so every position has four corners
+    columns_ = (width_ + cellSize_ - 1) / cellSize_ + 1;
+    rows_ = (height_ + cellSize_ - 1) / cellSize_ + 1;
+    maxX_ = std::nextafter(static_cast<float>(columns_ - 1), 0.0f);
+    maxY_ = std::nextafter(static_cast<float>(rows_ - 1), 0.0f);
+
+    const size_t size = static_cast<size_t>(columns_) * static_cast<size_t>(rows_);
+    previous_.assign(size, 0.0f);
+    next_.assign(size, 0.0f);
+    building_.assign(size, 0.0f);
+    current_.assign(size, 0.0f);
+    valid_ = false;
+    samples_ = 0;
+
+    // Noise coordinates of one row of samples
+    sampleX_.resize(static_cast<size_t>(columns_));
+    for (int column = 0; column < columns_; ++column)
+    {
+        sampleX_[static_cast<size_t>(column)] = (left_ + static_cast<float>(column * cellSize_)) * spatialScale_;
+    }
+    sampleY_.resize(sampleX_.size());
+    sampleZ_.resize(sampleX_.size());
+}
+
+void FlowField::Release() noexcept
+{
+    previous_ = {};
+    next_ = {};
+    building_ = {};
+    current_ = {};
+    sampleX_ = {};
+    sampleY_ = {};
+    sampleZ_ = {};
+    columns_ = 0;
+    rows_ = 0;
+    width_ = 0;
+    height_ = 0;
+    valid_ = false;
+}
+
+void FlowField::Advance(const FastNoiseLite& noise, const double time)
+{
+    if (!IsConfigured()) return;
+
+    // A jump past the slice being built (or a first call) starts over at time
+    if (!valid_ || time < sliceTime_ || time >= sliceTime_ + 2.0 * sliceInterval_)
+    {
+        Restart(noise, time);
+    }
+
+    // Crossing into the next interval promotes the slice being built
+    if (time >= sliceTime_ + sliceInterval_)
+    {
+        BuildRows(noise, building_, sliceTime_ + 2.0 * sliceInterval_, builtRows_, rows_);
+        std::swap(previous_, next_);
+        std::swap(next_, building_);
+        sliceTime_ += sliceInterval_;
+        builtRows_ = 0;
+    }
+
+    // Keep the slice being built as far along as the time is through its interval
+    const double progress = (time - sliceTime_) / sliceInterval_;
+    const int dueRows = std::min(static_cast<int>(std::ceil(progress * rows_)) + 1, rows_);
+    if (dueRows > builtRows_)
+    {
+        BuildRows(noise, building_, sliceTime_ + 2.0 * sliceInterval_, builtRows_, dueRows);
+        builtRows_ = dueRows;
+    }
+
+    const float blend = static_cast<float>(progress);
+    for (size_t i = 0; i < current_.size(); ++i)
+    {
+        current_[i] = previous_[i] + (next_[i] - previous_[i]) * blend;
+    }
+}
+
+void FlowField::Restart(const FastNoiseLite& noise, const double time)
+{
+    sliceTime_ = time;
+    BuildRows(noise, previous_, sliceTime_, 0, rows_);
+    BuildRows(noise, next_, sliceTime_ + sliceInterval_, 0, rows_);
+    builtRows_ = 0;
+    valid_ = true;
+}
+
+void FlowField::BuildRows(const FastNoiseLite& noise, std::vector<float>& slice, const double time,
+                          const int firstRow, const int endRow)
+{
+    // A row at a time through the batch API, which runs OpenSimplex2 in vector lanes
+    std::fill(sampleZ_.begin(), sampleZ_.end(), static_cast<float>(time));
+    for (int row = firstRow; row < endRow; ++row)
+    {
+        std::fill(sampleY_.begin(), sampleY_.end(), (top_ + static_cast<float>(row * cellSize_)) * spatialScale_);
+        float* out = slice.data() + static_cast<size_t>(row) * static_cast<size_t>(columns_);
+        noise.GetNoiseBatch(sampleX_.data(), sampleY_.data(), sampleZ_.data(), out, sampleX_.size());
+    }
+    samples_ += static_cast<size_t>(std::max(endRow - firstRow, 0)) * static_cast<size_t>(columns_);
+}
+
+} // namespace RainEngine
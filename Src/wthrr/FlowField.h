@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+class FastNoiseLite;
+
+namespace RainEngine {
+
+// A coarse cache of a time-varying 3D noise field over a pixel area.
+//
+// The noise is sampled every cellSize pixels at (x * spatialScale,
+// y * spatialScale, time) for a series of times sliceInterval apart. Two
+// finished slices bracket the current time and are blended once per Advance;
+// Sample then reads the blend with bilinear interpolation. The slice after
+// them is built a few rows per Advance, paced so it is complete by the time
+// it is needed. Callers scale cellSize with the display, so the noise cost of
+// a step stays about the same at every resolution.
+class FlowField {
+public:
+    // Pixels between neighbouring samples at a scale factor of 1 (1080p)
+    static constexpr int BASE_CELL_SIZE = 32;
+
+    // Cover width x height pixels from (left, top) with a sample every
+    // cellSize pixels. Drops every slice; the next Advance rebuilds them.
+    void Configure(float left, float top, int width, int height, int cellSize, float spatialScale,
+                   float sliceInterval);
+
+    // Move the field to time, which should not go backwards
+    void Advance(const FastNoiseLite& noise, double time);
+
+    // Noise at a pixel position; positions outside the area read its edge
+    [[nodiscard]] float Sample(float x, float y) const noexcept {
+        float gx = (x - left_) * invCellSize_;
+        float gy = (y - top_) * invCellSize_;
+        gx = gx < 0.0f ? 0.0f : gx > maxX_ ? maxX_ : gx;
+        gy = gy < 0.0f ? 0.0f : gy > maxY_ ? maxY_ : gy;
+
+        // maxX_ and maxY_ stop one cell short, so the far corners always exist
+        const int cx = static_cast<int>(gx);
+        const int cy = static_cast<int>(gy);
+        const float fx = gx - static_cast<float>(cx);
+        const float fy = gy - static_cast<float>(cy);
+        const float* top = current_.data() + static_cast<size_t>(cy) * static_cast<size_t>(columns_) + cx;
+        const float* bottom = top + columns_;
+        const float upper = top[0] + (top[1] - top[0]) * fx;
+        const float lower = bottom[0] + (bottom[1] - bottom[0]) * fx;
+        return upper + (lower - upper) * fy;
+    }
+
+    [[nodiscard]] bool IsConfigured() const noexcept { return columns_ > 0; }
+    [[nodiscard]] int GetWidth() const noexcept { return width_; }
+    [[nodiscard]] int GetHeight() const noexcept { return height_; }
+    [[nodiscard]] int GetCellSize() const noexcept { return cellSize_; }
+
+    // Noise samples taken since the field was configured
+    [[nodiscard]] size_t GetSampleCount() const noexcept { return samples_; }
+
+    // Free every slice
+    void Release() noexcept;
+
+private:
+    float left_ = 0.0f;
+    float top_ = 0.0f;
+    int width_ = 0;
+    int height_ = 0;
+    int cellSize_ = BASE_CELL_SIZE;
+    float invCellSize_ = 1.0f / BASE_CELL_SIZE;
+    float spatialScale_ = 1.0f;
+    double sliceInterval_ = 1.0;
+
+    int columns_ = 0;
+    int rows_ = 0;
+    float maxX_ = 0.0f;
+    float maxY_ = 0.0f;
+
+    // Slices at sliceTime_ and sliceTime_ + sliceInterval_, the one after
+    // them as far as it is built, and the blend Sample reads
+    std::vector<float> previous_;
+    std::vector<float> next_;
+    std::vector<float> building_;
+    std::vector<float> current_;
+    std::vector<float> sampleX_; // Noise coordinates of one row, for GetNoiseBatch
+    std::vector<float> sampleY_;
+    std::vector<float> sampleZ_;
+    double sliceTime_ = 0.0;
+    int builtRows_ = 0;
+    bool valid_ = false;
+    size_t samples_ = 0;
+
+    void BuildRows(const FastNoiseLite& noise, std::vector<float>& slice, double time, int firstRow, int endRow);
+    void Restart(const FastNoiseLite& noise, double time);
+};
+
+} // namespace RainEngine
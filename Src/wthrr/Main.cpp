@@ -69,14 +69,22 @@ int WINAPI WinMain(
             static constexpr auto TARGET_FRAME_TIME = std::chrono::microseconds{1000000 / TARGET_FPS};
             
             auto lastFrameTime = std::chrono::high_resolution_clock::now();
+
+            // One clock steps every display, so all of them see the same simulation time
+            RainEngine::SimulationClock clock;
+            auto lastTickTime = std::chrono::steady_clock::now();
             
             while (msg.message != WM_QUIT) {
                 if (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE)) {
                     TranslateMessage(&msg);
                     DispatchMessage(&msg);
                 } else {
+                    const auto tickTime = std::chrono::steady_clock::now();
+                    clock.BeginFrame(std::chrono::duration<double>(tickTime - lastTickTime).count());
+                    lastTickTime = tickTime;
+
                     for (const auto& rainWindow : rainWindows) {
-                        rainWindow->Animate();
+                        rainWindow->Animate(clock);
                     }
                     
                     sleepFor(lastFrameTime, TARGET_FRAME_TIME);
@@ -1,22 +1,25 @@
 #pragma once
-#include "windef.h"
-#include <d2d1.h>
 #include <algorithm>
+#include <cmath>
+#include "CoreTypes.h"
 #include "Vector2.h"
 
 class MathUtil
 {
 public:
-	// Function to check if a point is inside or on the edge of a RECT
-	static bool IsPointInRect(const RECT& rect, const Vector2& point)
+	using Rect = RainEngine::Rect;
+	using PointF = RainEngine::PointF;
+
+	// Function to check if a point is inside or on the edge of a Rect
+	static bool IsPointInRect(const Rect& rect, const Vector2& point)
 	{
 		// Check if the point is within or on the boundary of the rectangle
 		return (point.x >= rect.left && point.x <= rect.right && point.y >= rect.top && point.y <= rect.bottom);
 	}
 
 	// Helper function to calculate intersection
-	static bool LineIntersect(const D2D1_POINT_2F& p1, const D2D1_POINT_2F& p2, const D2D1_POINT_2F& q1,
-	                          const D2D1_POINT_2F& q2, D2D1_POINT_2F& intersection)
+	static bool LineIntersect(const PointF& p1, const PointF& p2, const PointF& q1,
+	                          const PointF& q2, PointF& intersection)
 	{
 		const float A1 = p2.y - p1.y;
 		const float B1 = p1.x - p2.x;
@@ -36,10 +39,10 @@ public:
 			intersection.y >= (std::min)(p1.y, p2.y) && intersection.y <= (std::max)(p1.y, p2.y));
 	}
 
-	static void TrimLineSegment(const RECT& boundRect, const D2D1_POINT_2F& lineStart, const D2D1_POINT_2F& lineEnd,
-	                            D2D1_POINT_2F& lineTrimmedStart, D2D1_POINT_2F& lineTrimmedEnd)
+	static void TrimLineSegment(const Rect& boundRect, const PointF& lineStart, const PointF& lineEnd,
+	                            PointF& lineTrimmedStart, PointF& lineTrimmedEnd)
 	{
-		const D2D1_POINT_2F rectPoints[4] = {
+		const PointF rectPoints[4] = {
 			{static_cast<float>(boundRect.left), static_cast<float>(boundRect.top)},
 			{static_cast<float>(boundRect.right), static_cast<float>(boundRect.top)},
 			{static_cast<float>(boundRect.right), static_cast<float>(boundRect.bottom)},
@@ -52,7 +55,7 @@ public:
 		for (int i = 0; i < 4; ++i)
 		{
 			const int next = (i + 1) % 4;
-			D2D1_POINT_2F intersection;
+			PointF intersection;
 			if (LineIntersect(lineStart, lineEnd, rectPoints[i], rectPoints[next], intersection))
 			{
 				if (!(lineTrimmedStart.x >= boundRect.left && lineTrimmedStart.x <= boundRect.right &&
@@ -78,9 +81,9 @@ public:
 		                              static_cast<float>(boundRect.bottom));
 	}
 
-	static RECT SubtractRect(const RECT& monitorRect, const RECT& taskBarRect)
+	static Rect SubtractRect(const Rect& monitorRect, const Rect& taskBarRect)
 	{
-		RECT result = {0, 0, 0, 0};
+		Rect result = {0, 0, 0, 0};
 
 		// Check if the taskBarRect is on the top edge and spans the full width
 		if (taskBarRect.top == monitorRect.top && taskBarRect.right == monitorRect.right && taskBarRect.left ==
@@ -113,9 +116,9 @@ public:
 		return result;
 	}
 
-	static RECT NormalizeRect(const RECT& monitorRect, const int top, const int left)
+	static Rect NormalizeRect(const Rect& monitorRect, const int top, const int left)
 	{
-		const RECT result = {
+		const Rect result = {
 			monitorRect.left - left, // left
 			monitorRect.top - top, // top
 			monitorRect.right - left, // right
@@ -141,7 +144,7 @@ public:
 		return firstPoint;
 	}
 
-	static bool IsSame(const RECT& l, const RECT& r)
+	static bool IsSame(const Rect& l, const Rect& r)
 	{
 		return l.left == r.left && l.top == r.top &&
 			l.right == r.right && l.bottom == r.bottom;
@@ -0,0 +1,68 @@
+#include "ParticleEmitter.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace RainEngine {
+
+void ParticleEmitter::SetRefillToCap(const size_t cap, const int rampSteps) noexcept
+{
+    mode_ = Mode::RefillToCap;
+    cap_ = cap;
+    rampSteps_ = std::max(1, rampSteps);
+}
+
+void ParticleEmitter::SetRate(const float particlesPerSecond, const size_t cap) noexcept
+{
+    if (mode_ != Mode::Rate)
+    {
+        carry_ = 0.0f;
+    }
+    mode_ = Mode::Rate;
+    rate_ = std::max(0.0f, particlesPerSecond);
+    cap_ = cap;
+}
+
+size_t ParticleEmitter::GetStepLimit(const float deltaSeconds) const noexcept
+{
+    if (mode_ == Mode::RefillToCap)
+    {
+        // Spread a full refill over rampSteps steps
+        return (cap_ + static_cast<size_t>(rampSteps_) - 1) / static_cast<size_t>(rampSteps_);
+    }
+    return static_cast<size_t>(std::ceil(rate_ * deltaSeconds));
+}
+
+int ParticleEmitter::Schedule(const size_t liveCount, const float deltaSeconds) noexcept
+{
+    if (liveCount >= cap_)
+    {
+        // Do not bank emission while the system is full
+        carry_ = 0.0f;
+        return 0;
+    }
+    const size_t deficit = cap_ - liveCount;
+
+    size_t count;
+    if (mode_ == Mode::RefillToCap)
+    {
+        count = std::min(deficit, GetStepLimit(deltaSeconds));
+    }
+    else
+    {
+        carry_ += rate_ * deltaSeconds;
+        const float whole = std::floor(carry_);
+        carry_ -= whole;
+        count = std::min(deficit, static_cast<size_t>(whole));
+    }
+
+    if (frameBudgetSteps_ > 0)
+    {
+        const size_t budget = GetFrameBudget(deltaSeconds);
+        count = std::min(count, budget > frameSpawned_ ? budget - frameSpawned_ : 0);
+    }
+    frameSpawned_ += count;
+    return static_cast<int>(count);
+}
+
+} // namespace RainEngine
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+
+namespace RainEngine {
+
+// Decides how many particles a system spawns on each fixed step.
+//
+// Refill mode tops the live count back up to a cap, but never spawns more
+// than cap / rampSteps per step, so filling an empty scene (startup, slider
+// moves) is spread over rampSteps steps instead of landing in one.
+// Rate mode emits a steady particlesPerSecond, carrying the fractional part
+// between steps, and still never exceeds the cap.
+// Both modes honour an optional per-frame budget: however many steps a
+// frame runs (catch-up, fast-forward), it spawns at most a fixed number of
+// steps' worth of particles.
+class ParticleEmitter {
+public:
+    enum class Mode {
+        RefillToCap,
+        Rate
+    };
+
+    ParticleEmitter() noexcept = default;
+
+    void SetRefillToCap(size_t cap, int rampSteps) noexcept;
+    void SetRate(float particlesPerSecond, size_t cap) noexcept;
+
+    // Start a frame that spawns at most budgetSteps steps' worth of
+    // particles over all its steps, 0 for no limit
+    void BeginFrame(int budgetSteps) noexcept {
+        frameBudgetSteps_ = budgetSteps;
+        frameSpawned_ = 0;
+    }
+
+    // Number of particles to spawn this step given the current live count
+    [[nodiscard]] int Schedule(size_t liveCount, float deltaSeconds) noexcept;
+
+    // Most particles one step of deltaSeconds may spawn in the current mode
+    [[nodiscard]] size_t GetStepLimit(float deltaSeconds) const noexcept;
+
+    // Particles scheduled since BeginFrame, and the frame's limit (0 for none)
+    [[nodiscard]] size_t GetFrameSpawned() const noexcept { return frameSpawned_; }
+    [[nodiscard]] size_t GetFrameBudget(float deltaSeconds) const noexcept {
+        return GetStepLimit(deltaSeconds) * static_cast<size_t>(frameBudgetSteps_ > 0 ? frameBudgetSteps_ : 0);
+    }
+
+    // Drop any carried fractional emission, e.g. after the scene was cleared
+    void Reset() noexcept { carry_ = 0.0f; }
+
+    [[nodiscard]] Mode GetMode() const noexcept { return mode_; }
+    [[nodiscard]] size_t GetCap() const noexcept { return cap_; }
+    [[nodiscard]] float GetRate() const noexcept { return rate_; }
+
+private:
+    Mode mode_ = Mode::RefillToCap;
+    size_t cap_ = 0;
+    int rampSteps_ = 1;
+    float rate_ = 0.0f;
+    int frameBudgetSteps_ = 0;
+    size_t frameSpawned_ = 0;
+    float carry_ = 0.0f;
+};
+
+} // namespace RainEngine
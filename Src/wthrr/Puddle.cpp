@@ -1,11 +1,16 @@
 #define NOMINMAX
 
 #include "Puddle.h"
+#include "DrawRecorder.h"
 #include "MathUtil.h"
 #include "RandomGenerator.h"
 
+#ifdef _WIN32
+#include <windows.h>
 #include <d2d1.h>
 #include <wrl/client.h>  // For Microsoft::WRL::ComPtr
+#include "Win32Interop.h"
+#endif
 #include <algorithm>
 #include <cmath>
 
@@ -53,54 +58,16 @@ void Puddle::Update(float deltaSeconds) noexcept
     TimeSinceLastRipple += deltaSeconds;
 }
 
-void Puddle::Draw(ID2D1DeviceContext* dc) const noexcept
+void Puddle::Record(RainEngine::DrawRecorder& recorder) const
 {
-    // Only draw if we have a valid size
     if (CurrentSize <= 0.0f)
         return;
-        
-    // Create a semi-transparent brush based on the drop color
-    const float alpha = my_min(0.4f, CurrentSize / MAX_PUDDLE_SIZE * 0.4f);
-    const D2D1_COLOR_F puddleColor = D2D1::ColorF(D2D1::ColorF::White, alpha);
-    
-    // Create a slightly darker color for the puddle
-    Microsoft::WRL::ComPtr<ID2D1SolidColorBrush> puddleBrush;
-    if (FAILED(dc->CreateSolidColorBrush(puddleColor, puddleBrush.GetAddressOf())))
-        return;
-    
-    // Draw the main puddle as an ellipse that's wider than tall
-    const D2D1_ELLIPSE ellipse = D2D1::Ellipse(
-        D2D1::Point2F(Pos.x, Pos.y), 
-        CurrentSize * 1.5f,  // Wider
-        CurrentSize * 0.7f   // Less tall
-    );
-    
-    // Draw the puddle with the drop color brush
-    dc->FillEllipse(ellipse, pDisplayData->DropColorBrush.Get());
-    
-    // Draw ripple effect if active
+
+    recorder.FillEllipse(Pos.ToPoint(), CurrentSize * 1.5f, CurrentSize * 0.7f);
     if (HasRipple)
     {
-        // Calculate ripple size and opacity based on animation progress
         const float rippleSize = CurrentSize * RIPPLE_SIZE_FACTOR * (0.5f + RippleProgress * 0.5f);
-        const float rippleOpacity = my_max(0.0f, 0.4f - RippleProgress * 0.4f);
-        
-        // Create ripple brush with fading opacity
-        const D2D1_COLOR_F rippleColor = D2D1::ColorF(D2D1::ColorF::White, rippleOpacity);
-        
-        Microsoft::WRL::ComPtr<ID2D1SolidColorBrush> rippleBrush;
-        if (SUCCEEDED(dc->CreateSolidColorBrush(rippleColor, rippleBrush.GetAddressOf())))
-        {
-            // Draw the ripple as a ring using stroke
-            const D2D1_ELLIPSE rippleEllipse = D2D1::Ellipse(
-                D2D1::Point2F(Pos.x, Pos.y), 
-                rippleSize * 1.5f,  // Wider
-                rippleSize * 0.7f   // Less tall
-            );
-            
-            // Draw the ripple with the drop color brush
-            dc->DrawEllipse(rippleEllipse, pDisplayData->DropColorBrush.Get(), 1.0f);
-        }
+        recorder.StrokeEllipse(Pos.ToPoint(), rippleSize * 1.5f, rippleSize * 0.7f, 1.0f);
     }
 }
 
@@ -157,55 +124,96 @@ void PuddleManager::Update(float deltaSeconds) noexcept
     );
 }
 
-void PuddleManager::Draw(ID2D1DeviceContext* dc) const noexcept
+void PuddleManager::Record(RainEngine::DrawRecorder& recorder) const
 {
-    // Draw all puddles
     for (const auto& puddle : Puddles)
     {
-        puddle->Draw(dc);
+        puddle->Record(recorder);
     }
 }
 
+#ifdef _WIN32
+void PuddleManager::Draw(ID2D1DeviceContext* dc) const
+{
+    RainEngine::DrawRecorder& commands = pDisplayData->GetDrawCommands();
+    commands.Clear();
+    Record(commands);
+    commands.Replay(dc, *pDisplayData);
+}
+#endif
+
 void PuddleManager::CreateOrAddToPuddle(const Vector2& pos) noexcept
 {
     // Ignore if not on taskbar
     if (!IsOnTaskbar(pos))
         return;
-        
-    // Try to find a nearby puddle to add to
-    Puddle* nearbyPuddle = FindNearbyPuddle(pos);
+
+    AddDropAt(pos, nullptr);
+}
+
+void PuddleManager::AddGroundHits(const std::vector<RainEngine::GroundHit>& hits) noexcept
+{
+    if (!HasTaskbarData || hits.empty())
+        return;
+
+    // Keep the hits on the taskbar and sort them left to right, so hits that
+    // land close together are resolved against the same puddle
+    TaskbarHits.clear();
+    for (const auto& hit : hits)
+    {
+        if (IsOnTaskbar(Vector2(hit.x, hit.y)))
+        {
+            TaskbarHits.push_back(hit);
+        }
+    }
+    std::sort(TaskbarHits.begin(), TaskbarHits.end(),
+        [](const RainEngine::GroundHit& a, const RainEngine::GroundHit& b) noexcept { return a.x < b.x; });
+
+    Puddle* lastPuddle = nullptr;
+    for (const auto& hit : TaskbarHits)
+    {
+        lastPuddle = AddDropAt(Vector2(hit.x, hit.y), lastPuddle);
+    }
+}
+
+Puddle* PuddleManager::AddDropAt(const Vector2& pos, Puddle* pHint) noexcept
+{
+    // Try the hinted puddle first, then any nearby puddle
+    Puddle* nearbyPuddle = (pHint && CalculateDistance(pos, pHint->GetPosition()) < MERGE_DISTANCE)
+        ? pHint
+        : FindNearbyPuddle(pos);
     
     if (nearbyPuddle)
     {
         // Add water to existing puddle
         nearbyPuddle->AddWater(ADD_WATER_AMOUNT);
+        return nearbyPuddle;
     }
-    else
+
+    // Create a new puddle if we have room
+    if (Puddles.size() < MAX_PUDDLES)
     {
-        // Create a new puddle if we have room
-        if (Puddles.size() < MAX_PUDDLES)
-        {
-            // Add slight randomness to position
-            Vector2 adjustedPos = pos;
-            adjustedPos.x += RandomGenerator::GetInstance().GenerateFloat(-2.0f, 2.0f);
-            
-            Puddles.emplace_back(std::make_unique<Puddle>(
-                pDisplayData, adjustedPos, INITIAL_SIZE));
-        }
-        else
-        {
-            // Find the smallest puddle and add water to it
-            const auto smallestIt = std::min_element(Puddles.begin(), Puddles.end(),
-                [](const std::unique_ptr<Puddle>& a, const std::unique_ptr<Puddle>& b) noexcept {
-                    return a->GetRadius() < b->GetRadius();
-                });
-                
-            if (smallestIt != Puddles.end())
-            {
-                (*smallestIt)->AddWater(ADD_WATER_AMOUNT);
-            }
-        }
+        // Add slight randomness to position
+        Vector2 adjustedPos = pos;
+        adjustedPos.x += RandomGenerator::GetInstance().GenerateFloat(-2.0f, 2.0f);
+        
+        Puddles.emplace_back(std::make_unique<Puddle>(
+            pDisplayData, adjustedPos, INITIAL_SIZE));
+        return Puddles.back().get();
     }
+
+    // Find the smallest puddle and add water to it
+    const auto smallestIt = std::min_element(Puddles.begin(), Puddles.end(),
+        [](const std::unique_ptr<Puddle>& a, const std::unique_ptr<Puddle>& b) noexcept {
+            return a->GetRadius() < b->GetRadius();
+        });
+        
+    if (smallestIt != Puddles.end())
+    {
+        (*smallestIt)->AddWater(ADD_WATER_AMOUNT);
+        return smallestIt->get();
+    }
+    return nullptr;
 }
 
 void PuddleManager::Reset() noexcept
@@ -242,14 +250,29 @@ Puddle* PuddleManager::FindNearbyPuddle(const Vector2& pos) const noexcept
     return nullptr;
 }
 
+void PuddleManager::SetTaskbarRect(const RainEngine::Rect& taskbarRect) noexcept
+{
+    if (!pDisplayData)
+        return;
+
+    TaskbarRect = taskbarRect;
+
+    // Normalize coordinates relative to scene rect
+    NormalizedRect = MathUtil::NormalizeRect(TaskbarRect, 
+                                            pDisplayData->SceneRect.top, 
+                                            pDisplayData->SceneRect.left);
+    HasTaskbarData = true;
+}
+
 void PuddleManager::CalculateTaskbarRegion() noexcept
 {
+#ifdef _WIN32
     // Find the taskbar window
     HWND hTaskbarWnd = nullptr;
     if (pDisplayData)
     {
-        const RECT& sceneRect = pDisplayData->SceneRect;
-        const RECT displayRect = {
+        const RainEngine::Rect& sceneRect = pDisplayData->SceneRect;
+        const RainEngine::Rect displayRect = {
             sceneRect.left,
             sceneRect.top,
             sceneRect.right,
@@ -265,26 +288,16 @@ void PuddleManager::CalculateTaskbarRegion() noexcept
             hTaskbarWnd = FindWindowW(L"Shell_SecondaryTrayWnd", nullptr);
         }
         
-        if (hTaskbarWnd)
+        RECT taskbarWindowRect;
+        if (hTaskbarWnd && GetWindowRect(hTaskbarWnd, &taskbarWindowRect))
         {
-            if (GetWindowRect(hTaskbarWnd, &TaskbarRect))
+            // Check if taskbar is at the bottom (most common case)
+            if (taskbarWindowRect.top > displayRect.bottom - 100)
             {
-                // Check if taskbar is at the bottom (most common case)
-                if (TaskbarRect.top > displayRect.bottom - 100)
-                {
-                    NormalizedRect.left = TaskbarRect.left;
-                    NormalizedRect.right = TaskbarRect.right;
-                    NormalizedRect.top = TaskbarRect.top;
-                    NormalizedRect.bottom = TaskbarRect.bottom;
-                    
-                    // Normalize coordinates relative to scene rect
-                    NormalizedRect = MathUtil::NormalizeRect(NormalizedRect, 
-                                                            pDisplayData->SceneRect.top, 
-                                                            pDisplayData->SceneRect.left);
-                    
-                    HasTaskbarData = true;
-                }
+                SetTaskbarRect(RainEngine::ToRect(taskbarWindowRect));
             }
         }
     }
-}
\ No newline at end of file
+#endif
+    // Headless hosts have no shell taskbar; they call SetTaskbarRect themselves
+}
@@ -2,12 +2,13 @@
 
 #include <vector>
 #include <memory>
-#include <d2d1.h>
+#include "CoreTypes.h"
 #include "Vector2.h"
 #include "DisplayData.h"
 
 // Forward declarations to reduce compilation dependencies
 struct ID2D1DeviceContext;
+namespace RainEngine { class DrawRecorder; }
 
 // Puddle class - represents small water accumulations on the taskbar
 class Puddle final
@@ -26,7 +27,8 @@ public:
 
     // Main interface functions
     void Update(float deltaSeconds) noexcept;
-    void Draw(ID2D1DeviceContext* dc) const noexcept;
+    // The puddle and its ripple, if any
+    void Record(RainEngine::DrawRecorder& recorder) const;
     void AddWater(float amount) noexcept;
     [[nodiscard]] bool IsReadyForRemoval() const noexcept;
     [[nodiscard]] const Vector2& GetPosition() const noexcept { return Pos; }
@@ -65,10 +67,20 @@ public:
     PuddleManager& operator=(PuddleManager&&) noexcept = default;
 
     void Update(float deltaSeconds) noexcept;
-    void Draw(ID2D1DeviceContext* dc) const noexcept;
+    // Record, then replay the commands through Direct2D
+    void Draw(ID2D1DeviceContext* dc) const;
+    void Record(RainEngine::DrawRecorder& recorder) const;
     void CreateOrAddToPuddle(const Vector2& pos) noexcept;
+
+    // Add one step's worth of ground hits in a single batch
+    void AddGroundHits(const std::vector<RainEngine::GroundHit>& hits) noexcept;
     void Reset() noexcept;
+
+    // Provide the taskbar rectangle (in global coordinates) directly, e.g. from a headless host
+    void SetTaskbarRect(const RainEngine::Rect& taskbarRect) noexcept;
     
+    [[nodiscard]] size_t GetPuddleCount() const noexcept { return Puddles.size(); }
+
     // Is this point on the taskbar?
     [[nodiscard]] bool IsOnTaskbar(const Vector2& pos) const noexcept;
 
@@ -80,15 +92,20 @@ private:
     
     DisplayData* pDisplayData;  // Non-owning pointer
     std::vector<std::unique_ptr<Puddle>> Puddles;
+    std::vector<RainEngine::GroundHit> TaskbarHits; // Scratch buffer for AddGroundHits
     
     // Find a nearby puddle, return nullptr if none found within MERGE_DISTANCE
     [[nodiscard]] Puddle* FindNearbyPuddle(const Vector2& pos) const noexcept;
+
+    // Add one drop of water at a taskbar position, trying pHint before searching.
+    // Returns the puddle that received the water.
+    Puddle* AddDropAt(const Vector2& pos, Puddle* pHint) noexcept;
     
     // Calculate taskbar region for puddle placement
     void CalculateTaskbarRegion() noexcept;
     
     // Taskbar region data
-    RECT TaskbarRect{};         // The global taskbar position
-    RECT NormalizedRect{};      // Normalized for puddle placement
+    RainEngine::Rect TaskbarRect{};     // The global taskbar position
+    RainEngine::Rect NormalizedRect{};  // Normalized for puddle placement
     bool HasTaskbarData;        // Whether taskbar data is valid
 };
\ No newline at end of file
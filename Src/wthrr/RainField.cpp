@@ -0,0 +1,247 @@
+#include "RainField.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "DrawRecorder.h"
+#include "MathUtil.h"
+#include "RandomGenerator.h"
+
+namespace RainEngine {
+
+RainField::RainField(DisplayData* pDispData) noexcept
+    : pDisplayData(pDispData), Splatters(pDispData)
+{
+}
+
+void RainField::Reserve(const size_t capacity)
+{
+    PosX.reserve(capacity);
+    PosY.reserve(capacity);
+    VelX.reserve(capacity);
+    VelY.reserve(capacity);
+    Radius.reserve(capacity);
+    DropTrailLength.reserve(capacity);
+    Flags.reserve(capacity);
+}
+
+void RainField::Spawn(const int count, const int windDirectionFactor)
+{
+    if (count <= 0) return;
+
+    Reserve(Size() + static_cast<size_t>(count));
+
+    auto& rng = RandomGenerator::GetInstance();
+    const float scaleFactor = pDisplayData->ScaleFactor;
+    const Rect& sceneRect = pDisplayData->SceneRect;
+
+    // Every drop spawned in one call shares the same wind and terminal velocity
+    const float velX = WIND_MULTIPLIER * windDirectionFactor * scaleFactor;
+    const float velY = TERMINAL_VELOCITY_Y * scaleFactor;
+
+    // Randomize x position with wind compensation, and y position above the scene
+    const int xWidenToAccountForSlant = pDisplayData->Width / 3;
+    const int minX = sceneRect.left - xWidenToAccountForSlant;
+    const int maxX = sceneRect.right + xWidenToAccountForSlant;
+    const int minY = sceneRect.top - pDisplayData->Height / 2;
+    const int maxY = sceneRect.top;
+
+    // The randoms for a block of drops are drawn a column at a time
+    constexpr int SPAWN_BLOCK = 64;
+    int xs[SPAWN_BLOCK], ys[SPAWN_BLOCK], radii[SPAWN_BLOCK], trails[SPAWN_BLOCK];
+    for (int first = 0; first < count; first += SPAWN_BLOCK)
+    {
+        const int n = std::min(SPAWN_BLOCK, count - first);
+        const size_t blockSize = static_cast<size_t>(n);
+        rng.FillInt(xs, blockSize, minX, maxX);
+        rng.FillInt(ys, blockSize, minY, maxY);
+        rng.FillInt(radii, blockSize, 2, 7);
+        rng.FillInt(trails, blockSize, 30, 100);
+
+        for (int i = 0; i < n; ++i)
+        {
+            PosX.push_back(static_cast<float>(xs[i]));
+
+            // y position quantized to improve performance
+            PosY.push_back(static_cast<float>((ys[i] / 10) * 10));
+
+            // Create drop with radius ranging from 0.2 to 0.7 pixels
+            Radius.push_back((radii[i] * 0.1f) * scaleFactor);
+
+            VelX.push_back(velX);
+            VelY.push_back(velY);
+
+            // Initialize length of the rain drop trail
+            DropTrailLength.push_back(trails[i] * scaleFactor);
+
+            Flags.push_back(0);
+        }
+    }
+
+    FallingCount += static_cast<size_t>(count);
+}
+
+void RainField::Update(const float deltaSeconds)
+{
+    const Rect& sceneRect = pDisplayData->SceneRect;
+    const float groundY = static_cast<float>(sceneRect.bottom);
+    const size_t count = Size();
+
+    // Splatters emitted by this step's hits start moving on the next step
+    Splatters.Update(deltaSeconds);
+    GroundHits.clear();
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::uint8_t flags = Flags[i];
+        if (flags & (FLAG_TOUCHED_GROUND | FLAG_DEAD)) continue;
+
+        // Update the position of the raindrop
+        PosX[i] += VelX[i] * deltaSeconds;
+        PosY[i] += VelY[i] * deltaSeconds;
+
+        if (PosY[i] + Radius[i] >= groundY)
+        {
+            // The drop itself is done once it lands; its splatters live on in the pool
+            flags |= FLAG_TOUCHED_GROUND | FLAG_DEAD;
+            PosY[i] = groundY;
+            --FallingCount;
+            DeadDrops.push_back(static_cast<std::uint32_t>(i));
+
+            const Vector2 pos(PosX[i], PosY[i]);
+            if (MathUtil::IsPointInRect(sceneRect, pos))
+            {
+                // if the rain touched ground inside bounds, create splatter.
+                CreateSplatters(pos);
+
+                // Record the hit for the batch consumers
+                GroundHits.push_back({pos.x, pos.y, Radius[i]});
+            }
+        }
+
+        Flags[i] = flags;
+    }
+}
+
+void RainField::CreateSplatters(const Vector2& pos)
+{
+    const float scaleFactor = pDisplayData->ScaleFactor;
+    const float splatterVelocity = SPLATTER_STARTING_VELOCITY * scaleFactor;
+
+    int angles[MAX_SPLATTER_PER_RAINDROP_];
+    RandomGenerator::GetInstance().FillInt(angles, MAX_SPLATTER_PER_RAINDROP_, 20, 70, 110, 160);
+
+    for (int i = 0; i < MAX_SPLATTER_PER_RAINDROP_; ++i)
+    {
+        const float angleBounceRadians = angles[i] * (PI / 180.0f);
+
+        // Calculate velocity components using cached values
+        const Vector2 velSplatter(
+            splatterVelocity * std::cos(angleBounceRadians),
+            -splatterVelocity * std::sin(angleBounceRadians));
+
+        Splatters.Emit(pos, velSplatter);
+    }
+}
+
+void RainField::RemoveDead() noexcept
+{
+    if (DeadDrops.empty()) return;
+
+    // Highest index first: every dead drop above the current one is gone by
+    // then, so the last drop is either live or the current one itself.
+    // Update notes deaths in index order, but several Updates may run
+    // between calls.
+    std::sort(DeadDrops.begin(), DeadDrops.end());
+    size_t count = Size();
+    for (auto it = DeadDrops.rbegin(); it != DeadDrops.rend(); ++it)
+    {
+        --count;
+        if (*it != count)
+        {
+            MoveDrop(count, *it);
+        }
+    }
+
+    PosX.resize(count);
+    PosY.resize(count);
+    VelX.resize(count);
+    VelY.resize(count);
+    Radius.resize(count);
+    DropTrailLength.resize(count);
+    Flags.resize(count);
+    DeadDrops.clear();
+}
+
+void RainField::MoveDrop(const size_t from, const size_t to) noexcept
+{
+    PosX[to] = PosX[from];
+    PosY[to] = PosY[from];
+    VelX[to] = VelX[from];
+    VelY[to] = VelY[from];
+    Radius[to] = Radius[from];
+    DropTrailLength[to] = DropTrailLength[from];
+    Flags[to] = Flags[from];
+}
+
+void RainField::Clear() noexcept
+{
+    PosX.clear();
+    PosY.clear();
+    VelX.clear();
+    VelY.clear();
+    Radius.clear();
+    DropTrailLength.clear();
+    Flags.clear();
+    Splatters.Clear();
+    GroundHits.clear();
+    FallingCount = 0;
+    DeadDrops.clear();
+}
+
+bool RainField::ShouldDrawRainLine(const Vector2& pos, const Vector2& prevPoint, const bool touchedGround) const noexcept
+{
+    return !touchedGround && (MathUtil::IsPointInRect(pDisplayData->SceneRect, pos) ||
+                              MathUtil::IsPointInRect(pDisplayData->SceneRect, prevPoint));
+}
+
+void RainField::Record(DrawRecorder& recorder) const
+{
+    const Rect& sceneRect = pDisplayData->SceneRect;
+    const size_t count = Size();
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const Vector2 pos(PosX[i], PosY[i]);
+        const Vector2 prevPoint = MathUtil::FindFirstPoint(DropTrailLength[i], pos, Vector2(VelX[i], VelY[i]));
+
+        if (ShouldDrawRainLine(pos, prevPoint, DidTouchGround(i)))
+        {
+            if (MathUtil::IsPointInRect(sceneRect, pos) &&
+                MathUtil::IsPointInRect(sceneRect, prevPoint))
+            {
+                recorder.Line(prevPoint.ToPoint(), pos.ToPoint(), Radius[i]);
+            }
+            else
+            {
+                PointF startPoint, endPoint;
+                MathUtil::TrimLineSegment(sceneRect, prevPoint.ToPoint(), pos.ToPoint(), startPoint, endPoint);
+                recorder.Line(startPoint, endPoint, Radius[i]);
+            }
+        }
+    }
+
+    Splatters.Record(recorder);
+}
+
+#ifdef _WIN32
+void RainField::Draw(ID2D1DeviceContext* dc) const
+{
+    DrawRecorder& commands = pDisplayData->GetDrawCommands();
+    commands.Clear();
+    Record(commands);
+    commands.Replay(dc, *pDisplayData);
+}
+#endif
+
+} // namespace RainEngine
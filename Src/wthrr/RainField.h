@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "DisplayData.h"
+#include "Splatter.h"
+#include "Vector2.h"
+
+// Forward declarations to keep Direct2D out of the simulation core
+struct ID2D1DeviceContext;
+
+namespace RainEngine {
+
+class DrawRecorder;
+
+// Structure-of-arrays storage for every rain drop on one display.
+// Each drop attribute lives in its own contiguous column, indexed by drop, so
+// the per-step update walks flat float/byte arrays instead of chasing
+// individually allocated drop objects.
+class RainField {
+public:
+    explicit RainField(DisplayData* pDispData) noexcept;
+    ~RainField() noexcept = default;
+
+    RainField(const RainField&) = delete;
+    RainField& operator=(const RainField&) = delete;
+
+    // Append count freshly initialized drops above the scene
+    void Spawn(int count, int windDirectionFactor);
+
+    // Advance every drop and the splatters of earlier ground hits by deltaSeconds.
+    // Replaces the ground hits buffer with the hits of this step.
+    void Update(float deltaSeconds);
+
+    // Drop every dead drop by moving the last drop into its slot.
+    // Visits only the drops that died since the last call, so the cost is
+    // O(dead) whatever the field size. Does not preserve drop order.
+    void RemoveDead() noexcept;
+
+    void Clear() noexcept;
+    void Reserve(size_t capacity);
+
+    [[nodiscard]] size_t Size() const noexcept { return PosX.size(); }
+    [[nodiscard]] bool IsEmpty() const noexcept { return PosX.empty(); }
+    // Counts kept up to date as drops spawn, land and are removed
+    [[nodiscard]] size_t GetLiveCount() const noexcept { return PosX.size() - DeadDrops.size(); }
+    [[nodiscard]] size_t GetFallingCount() const noexcept { return FallingCount; }
+
+    [[nodiscard]] bool DidTouchGround(size_t index) const noexcept { return (Flags[index] & FLAG_TOUCHED_GROUND) != 0; }
+    [[nodiscard]] bool IsReadyForErase(size_t index) const noexcept { return (Flags[index] & FLAG_DEAD) != 0; }
+    [[nodiscard]] Vector2 GetPosition(size_t index) const noexcept { return {PosX[index], PosY[index]}; }
+    [[nodiscard]] const SplatterPool& GetSplatters() const noexcept { return Splatters; }
+
+    // Drops that landed inside the scene during the last Update, in drop order
+    [[nodiscard]] const std::vector<GroundHit>& GetGroundHits() const noexcept { return GroundHits; }
+
+    // Record, then replay the commands through Direct2D
+    void Draw(ID2D1DeviceContext* dc) const;
+    // Every visible rain line, then the splatters
+    void Record(DrawRecorder& recorder) const;
+
+private:
+    static constexpr int MAX_SPLATTER_PER_RAINDROP_ = 3;
+    static constexpr float PI = 3.14159265359f;
+
+    static constexpr float TERMINAL_VELOCITY_Y = 1000; //pixels per second
+    static constexpr float WIND_MULTIPLIER = 75; // pixels per second
+
+    static constexpr float SPLATTER_STARTING_VELOCITY = 200.0f;
+
+    static constexpr std::uint8_t FLAG_TOUCHED_GROUND = 1 << 0;
+    static constexpr std::uint8_t FLAG_DEAD = 1 << 1;
+
+    DisplayData* pDisplayData; // Non-owning pointer
+
+    // Per-drop columns
+    std::vector<float> PosX;
+    std::vector<float> PosY;
+    std::vector<float> VelX;
+    std::vector<float> VelY;
+    std::vector<float> Radius;
+    std::vector<float> DropTrailLength;
+    std::vector<std::uint8_t> Flags;
+
+    size_t FallingCount = 0; // Drops that have not touched the ground yet
+
+    // Indices of dead drops still waiting for RemoveDead, noted as they land
+    std::vector<std::uint32_t> DeadDrops;
+
+    // Splatters outlive the drop that threw them, so the field owns them in one pool
+    SplatterPool Splatters;
+
+    // Per-step hit buffer, reused so steady-state rain does not allocate
+    std::vector<GroundHit> GroundHits;
+
+    void CreateSplatters(const Vector2& pos);
+    void MoveDrop(size_t from, size_t to) noexcept;
+    [[nodiscard]] bool ShouldDrawRainLine(const Vector2& pos, const Vector2& prevPoint, bool touchedGround) const noexcept;
+};
+
+} // namespace RainEngine
@@ -1,23 +1,123 @@
 #pragma once
 
-#include <random>
-#include <mutex>
-#include <shared_mutex>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <concepts>
+#include <cstdint>
+#include <iterator>
+#include <random>
 #include <type_traits>
 
+#include "CounterRandom.h"
+
 namespace RainEngine {
 
-// Modern thread-safe random number generator using C++20 concepts
+// xoshiro256** (Blackman and Vigna): 256 bits of state and a handful of
+// shifts, rotates and multiplies per 64-bit output. Meets the standard
+// UniformRandomBitGenerator requirements, so it also drives <random>.
+class Xoshiro256 {
+public:
+    using result_type = std::uint64_t;
+
+    constexpr Xoshiro256() noexcept = default;
+    explicit constexpr Xoshiro256(const std::uint64_t value) noexcept { seed(value); }
+
+    // Expand one 64-bit seed into the full state with splitmix64, which never
+    // produces the all-zero state
+    constexpr void seed(std::uint64_t value) noexcept {
+        for (auto& word : s_) {
+            value += CounterRandom::GOLDEN_GAMMA;
+            word = CounterRandom::Mix(value);
+        }
+    }
+
+    [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
+    [[nodiscard]] static constexpr result_type max() noexcept { return ~result_type{0}; }
+
+    constexpr result_type operator()() noexcept {
+        const std::uint64_t result = Rotl(s_[1] * 5, 7) * 9;
+        const std::uint64_t t = s_[1] << 17;
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = Rotl(s_[3], 45);
+        return result;
+    }
+
+private:
+    [[nodiscard]] static constexpr std::uint64_t Rotl(const std::uint64_t x, const int k) noexcept {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    std::uint64_t s_[4]{};
+};
+
+// Xoshiro256** on LANES independent streams side by side, for the batch
+// fills. Every lane takes the same steps (the multiplies are by 5 and 9), so
+// the compiler can run a whole step in vector registers.
+class Xoshiro256Lanes {
+public:
+    static constexpr size_t LANES = 8;
+
+    // Each lane expands its own key of value, as Xoshiro256::seed does
+    constexpr void seed(const std::uint64_t value) noexcept {
+        for (size_t l = 0; l < LANES; ++l) {
+            std::uint64_t z = CounterRandom::Key(value, l, 0);
+            std::uint64_t* words[4] = {&s0_[l], &s1_[l], &s2_[l], &s3_[l]};
+            for (auto* word : words) {
+                z += CounterRandom::GOLDEN_GAMMA;
+                *word = CounterRandom::Mix(z);
+            }
+        }
+    }
+
+    // One value from every lane
+    constexpr void Next(std::uint64_t (&out)[LANES]) noexcept {
+        for (size_t l = 0; l < LANES; ++l) {
+            const std::uint64_t x = s1_[l] * 5;
+            out[l] = ((x << 7) | (x >> 57)) * 9;
+            const std::uint64_t t = s1_[l] << 17;
+            s2_[l] ^= s0_[l];
+            s3_[l] ^= s1_[l];
+            s1_[l] ^= s2_[l];
+            s0_[l] ^= s3_[l];
+            s2_[l] ^= t;
+            s3_[l] = (s3_[l] << 45) | (s3_[l] >> 19);
+        }
+    }
+
+private:
+    std::uint64_t s0_[LANES]{};
+    std::uint64_t s1_[LANES]{};
+    std::uint64_t s2_[LANES]{};
+    std::uint64_t s3_[LANES]{};
+};
+
+// Random numbers for the simulation, from one small generator per thread.
+//
+// No call takes a lock: each thread draws from its own Xoshiro256, seeded
+// from the shared seed and the thread's stream number. Streams are numbered
+// in the order threads first draw, or set with SetThreadStream, so a given
+// seed replays the same values on each stream. Seed reseeds every thread
+// before its next draw.
+//
+// The Fill calls draw many values at once from a separate set of lanes, for
+// spawning particles in bulk. They follow the same distributions as the
+// matching Generate calls, but not the same sequence.
 class RandomGenerator {
 public:
+    using Engine = Xoshiro256;
+
     // Delete copy and move operations for singleton
     RandomGenerator(const RandomGenerator&) = delete;
     RandomGenerator& operator=(const RandomGenerator&) = delete;
     RandomGenerator(RandomGenerator&&) = delete;
     RandomGenerator& operator=(RandomGenerator&&) = delete;
 
-    // Thread-safe singleton instance using std::call_once
+    // Thread-safe singleton instance (function-local static)
     [[nodiscard]] static RandomGenerator& GetInstance() noexcept {
         static RandomGenerator instance;
         return instance;
@@ -26,93 +126,225 @@ public:
     // Modern templated interface with concepts (C++20)
     template<std::integral T>
     [[nodiscard]] T GenerateInt(T min, T max) noexcept {
-        std::shared_lock lock(mutex_);
-        return std::uniform_int_distribution<T>{min, max}(generator_);
+        return UniformInt(ThreadEngine(), min, max);
     }
 
     template<std::floating_point T>
     [[nodiscard]] T GenerateFloat(T min, T max) noexcept {
-        std::shared_lock lock(mutex_);
-        return std::uniform_real_distribution<T>{min, max}(generator_);
+        return min + (max - min) * UnitReal<T>(ThreadEngine()());
     }
 
     // Specialized method for dual range generation (preserving original functionality)
     template<std::integral T>
     [[nodiscard]] T GenerateInt(T range1Min, T range1Max, T range2Min, T range2Max) noexcept {
-        std::shared_lock lock(mutex_);
-        
+        Engine& engine = ThreadEngine();
+
         const auto range1Size = range1Max - range1Min + 1;
         const auto range2Size = range2Max - range2Min + 1;
         const auto totalSize = range1Size + range2Size;
-        
-        const auto choice = std::uniform_int_distribution<T>{0, totalSize - 1}(generator_);
-        
+
+        const auto choice = UniformInt<T>(engine, 0, totalSize - 1);
+
         if (choice < range1Size) {
-            return std::uniform_int_distribution<T>{range1Min, range1Max}(generator_);
+            return UniformInt(engine, range1Min, range1Max);
         } else {
-            return std::uniform_int_distribution<T>{range2Min, range2Max}(generator_);
+            return UniformInt(engine, range2Min, range2Max);
         }
     }
 
     // Boolean generation
     [[nodiscard]] bool GenerateBool(double probability = 0.5) noexcept {
-        std::shared_lock lock(mutex_);
-        return std::bernoulli_distribution{probability}(generator_);
+        return UnitReal<double>(ThreadEngine()()) < probability;
     }
 
-    // Normal distribution
+    // Normal distribution (Box-Muller, one value per call)
     template<std::floating_point T>
     [[nodiscard]] T GenerateNormal(T mean = T{0}, T stddev = T{1}) noexcept {
-        std::shared_lock lock(mutex_);
-        return std::normal_distribution<T>{mean, stddev}(generator_);
+        Engine& engine = ThreadEngine();
+        const double radius = std::sqrt(-2.0 * std::log(1.0 - UnitReal<double>(engine())));
+        const double angle = 6.283185307179586 * UnitReal<double>(engine());
+        return mean + stddev * static_cast<T>(radius * std::cos(angle));
     }
 
     // Exponential distribution
     template<std::floating_point T>
     [[nodiscard]] T GenerateExponential(T lambda = T{1}) noexcept {
-        std::shared_lock lock(mutex_);
-        return std::exponential_distribution<T>{lambda}(generator_);
+        return static_cast<T>(-std::log(1.0 - UnitReal<double>(ThreadEngine()()))) / lambda;
     }
 
     // Generate random element from container
     template<typename Container>
-    [[nodiscard]] auto& GenerateChoice(Container& container) noexcept 
+    [[nodiscard]] auto& GenerateChoice(Container& container) noexcept
         requires requires { container.size(); container.begin(); } {
-        
-        std::shared_lock lock(mutex_);
-        auto dist = std::uniform_int_distribution<size_t>{0, container.size() - 1};
+
         auto it = container.begin();
-        std::advance(it, dist(generator_));
+        std::advance(it, UniformInt<size_t>(ThreadEngine(), 0, container.size() - 1));
         return *it;
     }
 
-    // Seed the generator (thread-safe)
-    void Seed(uint_fast32_t seed) noexcept {
-        std::unique_lock lock(mutex_);
-        generator_.seed(seed);
+    // count uniform values in [min, max) into out
+    template<std::floating_point T>
+    void FillFloat(T* out, const size_t count, const T min, const T max) noexcept {
+        Xoshiro256Lanes& lanes = SeededState().Lanes;
+        const T span = max - min;
+        std::uint64_t bits[LANES];
+        T values[LANES];
+        for (size_t i = 0; i < count; i += LANES) {
+            lanes.Next(bits);
+            for (size_t l = 0; l < LANES; ++l) {
+                values[l] = min + span * UnitReal<T>(bits[l]);
+            }
+            std::copy_n(values, std::min(LANES, count - i), out + i);
+        }
+    }
+
+    // count uniform values in [min, max] into out
+    template<std::integral T>
+    void FillInt(T* out, const size_t count, const T min, const T max) noexcept {
+        if constexpr (sizeof(T) > sizeof(std::uint32_t)) {
+            Engine& engine = ThreadEngine();
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = UniformInt(engine, min, max);
+            }
+        } else {
+            using U = std::make_unsigned_t<T>;
+            Xoshiro256Lanes& lanes = SeededState().Lanes;
+            const std::uint64_t range = static_cast<std::uint64_t>(static_cast<U>(max) - static_cast<U>(min)) + 1;
+            std::uint64_t bits[LANES];
+            T values[LANES];
+            for (size_t i = 0; i < count; i += LANES) {
+                lanes.Next(bits);
+                for (size_t l = 0; l < LANES; ++l) {
+                    values[l] = static_cast<T>(static_cast<U>(min) + static_cast<U>(((bits[l] >> 32) * range) >> 32));
+                }
+                std::copy_n(values, std::min(LANES, count - i), out + i);
+            }
+        }
+    }
+
+    // count values into out, each as from the dual range GenerateInt: uniform
+    // over both ranges together, so one draw picks the range and the value
+    template<std::integral T>
+    void FillInt(T* out, const size_t count, const T range1Min, const T range1Max,
+                 const T range2Min, const T range2Max) noexcept
+        requires (sizeof(T) <= sizeof(std::uint32_t)) {
+
+        using U = std::make_unsigned_t<T>;
+        Xoshiro256Lanes& lanes = SeededState().Lanes;
+        const std::uint64_t range1Size = static_cast<std::uint64_t>(static_cast<U>(range1Max) - static_cast<U>(range1Min)) + 1;
+        const std::uint64_t range2Size = static_cast<std::uint64_t>(static_cast<U>(range2Max) - static_cast<U>(range2Min)) + 1;
+        const std::uint64_t totalSize = range1Size + range2Size;
+        std::uint64_t bits[LANES];
+        T values[LANES];
+        for (size_t i = 0; i < count; i += LANES) {
+            lanes.Next(bits);
+            for (size_t l = 0; l < LANES; ++l) {
+                const std::uint64_t choice = ((bits[l] >> 32) * totalSize) >> 32;
+                const U first = static_cast<U>(static_cast<U>(range1Min) + static_cast<U>(choice));
+                const U second = static_cast<U>(static_cast<U>(range2Min) + static_cast<U>(choice - range1Size));
+                values[l] = static_cast<T>(choice < range1Size ? first : second);
+            }
+            std::copy_n(values, std::min(LANES, count - i), out + i);
+        }
+    }
+
+    // Seed every thread's generator; each reseeds before its next draw
+    void Seed(const std::uint64_t seed) noexcept {
+        seed_.store(seed, std::memory_order_relaxed);
+        generation_.fetch_add(1, std::memory_order_release);
     }
 
     // Seed with random device
     void SeedWithRandomDevice() noexcept {
-        std::unique_lock lock(mutex_);
-        generator_.seed(randomDevice_());
+        Seed(DeviceSeed());
     }
 
-    // Get engine for advanced usage (not recommended for general use)
+    [[nodiscard]] std::uint64_t GetSeed() const noexcept { return seed_.load(std::memory_order_relaxed); }
+
+    // Draw the calling thread's values from stream instead of the next free one
+    void SetThreadStream(const std::uint64_t stream) noexcept {
+        ThreadState& state = LocalState();
+        state.Stream = stream;
+        state.HasStream = true;
+        state.Generation = 0; // Reseed on the next draw
+    }
+
+    // Get the calling thread's engine for advanced usage (not recommended for general use)
     template<typename Func>
     decltype(auto) WithEngine(Func&& func) {
-        std::unique_lock lock(mutex_);
-        return func(generator_);
+        return func(ThreadEngine());
     }
 
 private:
-    RandomGenerator() noexcept : generator_(randomDevice_()) {
-        // Constructor initializes with random device seed
+    static constexpr size_t LANES = Xoshiro256Lanes::LANES;
+
+    struct ThreadState {
+        Engine Generator;
+        Xoshiro256Lanes Lanes;
+        std::uint64_t Generation = 0; // Seed generation Generator was seeded for, 0 = never
+        std::uint64_t Stream = 0;
+        bool HasStream = false;
+    };
+
+    RandomGenerator() noexcept : seed_(DeviceSeed()) {
+    }
+
+    [[nodiscard]] static std::uint64_t DeviceSeed() noexcept {
+        std::random_device device;
+        return (static_cast<std::uint64_t>(device()) << 32) ^ static_cast<std::uint64_t>(device());
+    }
+
+    // Constant-initialized, so reaching it costs no guard check
+    [[nodiscard]] static ThreadState& LocalState() noexcept {
+        static thread_local ThreadState state;
+        return state;
     }
 
-    std::random_device randomDevice_;
-    std::mt19937 generator_;
-    mutable std::shared_mutex mutex_; // Allows multiple concurrent reads
+    [[nodiscard]] ThreadState& SeededState() noexcept {
+        ThreadState& state = LocalState();
+        const std::uint64_t generation = generation_.load(std::memory_order_acquire);
+        if (state.Generation != generation) [[unlikely]] {
+            if (!state.HasStream) {
+                state.Stream = nextStream_.fetch_add(1, std::memory_order_relaxed);
+                state.HasStream = true;
+            }
+            const std::uint64_t seed = seed_.load(std::memory_order_relaxed);
+            state.Generator.seed(CounterRandom::Key(seed, state.Stream, 0));
+            state.Lanes.seed(CounterRandom::Key(seed, state.Stream, 1));
+            state.Generation = generation;
+        }
+        return state;
+    }
+
+    [[nodiscard]] Engine& ThreadEngine() noexcept { return SeededState().Generator; }
+
+    // Uniform in [min, max] from the top 32 bits by multiply-shift; wider
+    // types go through the standard distribution
+    template<std::integral T>
+    [[nodiscard]] static T UniformInt(Engine& engine, const T min, const T max) noexcept {
+        using U = std::make_unsigned_t<T>;
+        if constexpr (sizeof(T) <= sizeof(std::uint32_t)) {
+            const std::uint64_t range = static_cast<std::uint64_t>(static_cast<U>(max) - static_cast<U>(min)) + 1;
+            return static_cast<T>(static_cast<U>(min) + static_cast<U>(((engine() >> 32) * range) >> 32));
+        } else {
+            return std::uniform_int_distribution<T>{min, max}(engine);
+        }
+    }
+
+    // Uniform in [0, 1) from the top mantissa-width bits (through int32 for
+    // floats, which converts in vector registers)
+    template<std::floating_point T>
+    [[nodiscard]] static constexpr T UnitReal(const std::uint64_t bits) noexcept {
+        if constexpr (sizeof(T) <= sizeof(float)) {
+            return static_cast<T>(static_cast<float>(static_cast<std::int32_t>(bits >> 40)) * (1.0f / 16777216.0f));
+        } else {
+            return static_cast<T>(static_cast<double>(bits >> 11) * (1.0 / 9007199254740992.0));
+        }
+    }
+
+    std::atomic<std::uint64_t> seed_;
+    std::atomic<std::uint64_t> generation_{1};
+    std::atomic<std::uint64_t> nextStream_{0};
 };
 
 // Convenience functions for common use cases
@@ -141,9 +373,17 @@ namespace Random {
     [[nodiscard]] inline auto& Choice(Container& container) noexcept {
         return RandomGenerator::GetInstance().GenerateChoice(container);
     }
+
+    inline void FillFloat(float* out, size_t count, float min = 0.0f, float max = 1.0f) noexcept {
+        RandomGenerator::GetInstance().FillFloat(out, count, min, max);
+    }
+
+    inline void FillInt(int* out, size_t count, int min, int max) noexcept {
+        RandomGenerator::GetInstance().FillInt(out, count, min, max);
+    }
 }
 
 } // namespace RainEngine
 
 // Type alias for backward compatibility during transition
-using RandomGenerator = RainEngine::RandomGenerator;
\ No newline at end of file
+using RandomGenerator = RainEngine::RandomGenerator;
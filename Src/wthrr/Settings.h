@@ -0,0 +1,98 @@
+#pragma once
+
+#include "CoreTypes.h"
+
+namespace RainEngine {
+
+// Modern C++20 constants
+inline constexpr int MAX_PARTICLES = 75;
+
+// Modern enum class for type safety
+enum class ParticleType : int {
+    Rain = 0,
+    Snow = 1
+};
+
+// How settled snow is drawn: one shape per snow run, or a single bitmap
+// layer updated through dirty rectangles
+enum class SnowRenderMode : int {
+    Shapes = 0,
+    Bitmap = 1
+};
+
+// How settled snow is stored and settled: every cell in a grid, or one
+// column height per x with angle-of-repose relaxation
+enum class SnowModelType : int {
+    Grid = 0,
+    Heightmap = 1
+};
+
+// Modern settings class with C++20 features
+class Setting {
+public:
+    bool loaded = false;
+    int MaxParticles;
+    int WindSpeed;
+    ColorRef ParticleColor;
+    ParticleType PartType;
+    
+    // Lightning settings
+    int LightningFrequency;  // 0-100 scale, 50 = default
+    int LightningIntensity;  // 0-100 scale, 50 = default
+
+    // Snow wind randomness settings
+    bool EnableSnowWind;      // Whether to enable random wind for snow
+    int SnowWindIntensity;    // 0-100 scale, how strong the wind is
+    int SnowWindVariability;  // 0-100 scale, how frequently the wind changes
+
+    SnowRenderMode SnowRender; // Settled snow drawing path
+    SnowModelType SnowModel;   // Settled snow storage and settling rules
+    int SnowCellSize;          // Pixels per settled snow cell, 0 = follow the display scale
+
+    // Modern constructor with designated initializers support
+    explicit constexpr Setting(
+        int maxParticles = 10, 
+        int windSpeed = 3, 
+        ColorRef particleColor = 0x00AAAAAA, 
+        ParticleType partType = ParticleType::Rain,
+        int lightningFrequency = 50,
+        int lightningIntensity = 50,
+        bool enableSnowWind = false,
+        int snowWindIntensity = 25,
+        int snowWindVariability = 50,
+        SnowRenderMode snowRender = SnowRenderMode::Shapes,
+        SnowModelType snowModel = SnowModelType::Grid,
+        int snowCellSize = 0) noexcept
+        : MaxParticles(maxParticles)
+        , WindSpeed(windSpeed)
+        , ParticleColor(particleColor)
+        , PartType(partType)
+        , LightningFrequency(lightningFrequency)
+        , LightningIntensity(lightningIntensity)
+        , EnableSnowWind(enableSnowWind)
+        , SnowWindIntensity(snowWindIntensity)
+        , SnowWindVariability(snowWindVariability)
+        , SnowRender(snowRender)
+        , SnowModel(snowModel)
+        , SnowCellSize(snowCellSize) {
+    }
+
+    // Default copy/move operations
+    Setting(const Setting&) = default;
+    Setting& operator=(const Setting&) = default;
+    Setting(Setting&&) = default;
+    Setting& operator=(Setting&&) = default;
+    ~Setting() = default;
+};
+
+} // namespace RainEngine
+
+// Backward compatibility aliases
+using ParticleType = RainEngine::ParticleType;
+using Setting = RainEngine::Setting;
+using SnowRenderMode = RainEngine::SnowRenderMode;
+using SnowModelType = RainEngine::SnowModelType;
+
+// Enum value aliases for backward compatibility
+inline constexpr auto RAIN = ParticleType::Rain;
+inline constexpr auto SNOW = ParticleType::Snow;
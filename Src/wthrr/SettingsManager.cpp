@@ -9,7 +9,7 @@
 using namespace RainEngine;
 
 SettingsManager::SettingsManager() noexcept 
-    : defaultSetting_(MAX_PARTICLES, 3, 0x00AAAAAA, ParticleType::Rain, 50, 50, false, 25, 50) {
+    : defaultSetting_(MAX_PARTICLES, 3, 0x00AAAAAA, ParticleType::Rain, 50, 50, false, 25, 50, SnowRenderMode::Shapes, SnowModelType::Grid, 0) {
     const std::wstring appDataPath = GetAppDataPath();
     iniFilePath_ = appDataPath + L"\\wthrr.ini";
 }
@@ -56,6 +56,17 @@ void SettingsManager::CreateINIFile() const noexcept {
     WritePrivateProfileString(L"Settings", L"SnowWindVariability", 
                              std::to_wstring(defaultSetting_.SnowWindVariability).c_str(),
                              iniFilePath_.c_str());
+
+    // Settled snow drawing path, model and cell size
+    WritePrivateProfileString(L"Settings", L"SnowRenderMode", 
+                             std::to_wstring(static_cast<int>(defaultSetting_.SnowRender)).c_str(),
+                             iniFilePath_.c_str());
+    WritePrivateProfileString(L"Settings", L"SnowModel", 
+                             std::to_wstring(static_cast<int>(defaultSetting_.SnowModel)).c_str(),
+                             iniFilePath_.c_str());
+    WritePrivateProfileString(L"Settings", L"SnowCellSize", 
+                             std::to_wstring(defaultSetting_.SnowCellSize).c_str(),
+                             iniFilePath_.c_str());
 }
 
 SettingsManager& SettingsManager::GetInstance() noexcept {
@@ -105,6 +116,21 @@ void SettingsManager::ReadSettings(Setting& setting) const noexcept {
                                                       defaultSetting_.SnowWindVariability,
                                                       iniFilePath_.c_str());
 
+    // Settled snow drawing path, model and cell size
+    const int snowRenderInt = GetPrivateProfileInt(L"Settings", L"SnowRenderMode", 
+                                                  static_cast<int>(defaultSetting_.SnowRender),
+                                                  iniFilePath_.c_str());
+    setting.SnowRender = snowRenderInt == static_cast<int>(SnowRenderMode::Bitmap) ? SnowRenderMode::Bitmap
+                                                                                  : SnowRenderMode::Shapes;
+    const int snowModelInt = GetPrivateProfileInt(L"Settings", L"SnowModel", 
+                                                 static_cast<int>(defaultSetting_.SnowModel),
+                                                 iniFilePath_.c_str());
+    setting.SnowModel = snowModelInt == static_cast<int>(SnowModelType::Heightmap) ? SnowModelType::Heightmap
+                                                                                  : SnowModelType::Grid;
+    setting.SnowCellSize = GetPrivateProfileInt(L"Settings", L"SnowCellSize", 
+                                               defaultSetting_.SnowCellSize,
+                                               iniFilePath_.c_str());
+
     WriteSettings(setting);
     setting.loaded = true;
 }
@@ -143,4 +169,15 @@ void SettingsManager::WriteSettings(const Setting& setting) const noexcept {
     WritePrivateProfileString(L"Settings", L"SnowWindVariability", 
                              std::to_wstring(setting.SnowWindVariability).c_str(),
                              iniFilePath_.c_str());
+
+    // Settled snow drawing path, model and cell size
+    WritePrivateProfileString(L"Settings", L"SnowRenderMode", 
+                             std::to_wstring(static_cast<int>(setting.SnowRender)).c_str(),
+                             iniFilePath_.c_str());
+    WritePrivateProfileString(L"Settings", L"SnowModel", 
+                             std::to_wstring(static_cast<int>(setting.SnowModel)).c_str(),
+                             iniFilePath_.c_str());
+    WritePrivateProfileString(L"Settings", L"SnowCellSize", 
+                             std::to_wstring(setting.SnowCellSize).c_str(),
+                             iniFilePath_.c_str());
 }
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace RainEngine {
+
+// Settled snow of one display, as seen by flakes and renderers.
+//
+// Cells are addressed in scene pixels, (0, 0) top-left. Out-of-bounds cells
+// are never snow and never air; the settling rules treat them as solid
+// ground. Every row carries a change counter that is bumped whenever any of
+// its cells change, so renderers can cache per-row output and rebuild only
+// the rows whose counter moved since they last looked.
+//
+// SnowGrid stores every cell; SnowHeightmap stores one column height per x
+// and is the cheaper choice when snow only piles up from the bottom.
+class SettledSnow {
+public:
+    virtual ~SettledSnow() = default;
+
+    SettledSnow(const SettledSnow&) = delete;
+    SettledSnow& operator=(const SettledSnow&) = delete;
+
+    [[nodiscard]] int GetWidth() const noexcept { return width_; }
+    [[nodiscard]] int GetHeight() const noexcept { return height_; }
+    [[nodiscard]] size_t GetWordsPerRow() const noexcept { return wordsPerRow_; }
+    [[nodiscard]] std::uint64_t GetSeed() const noexcept { return seed_; }
+    [[nodiscard]] std::uint64_t GetPassCount() const noexcept { return passIndex_; }
+
+    // Restart the decision streams from pass 0 with a new seed
+    void Reseed(std::uint64_t seed) noexcept { seed_ = seed; passIndex_ = 0; }
+
+    // Change counter of row y; differs from an earlier read iff the row changed since
+    [[nodiscard]] std::uint32_t GetRowVersion(int y) const noexcept { return rowVersion_[static_cast<size_t>(y)]; }
+
+    // Snow at (x, y); false when out of bounds
+    [[nodiscard]] virtual bool IsSnow(int x, int y) const noexcept = 0;
+
+    // Empty cell snow can flow into at (x, y); false when out of bounds
+    [[nodiscard]] virtual bool IsAir(int x, int y) const noexcept = 0;
+
+    // A flake settles at (x, y). Caller guarantees the cell is inside the scene.
+    virtual void SetSnow(int x, int y) = 0;
+
+    // Row y as GetWordsPerRow() words, pixel x in bit (x % 64) of word x / 64;
+    // bits past the width are zero
+    virtual void ReadRow(int y, std::uint64_t* out) const noexcept = 0;
+
+    // One settling pass; rows above topRow are left alone
+    virtual void Settle(int topRow, float accumulationChance) = 0;
+
+    virtual void Clear() noexcept = 0;
+    [[nodiscard]] virtual size_t CountSnow() const noexcept = 0;
+
+    // Bytes held for cells and change counters
+    [[nodiscard]] virtual size_t GetMemoryUsage() const noexcept = 0;
+
+    // Chunks still being settled, 0 for models without sleeping chunks
+    [[nodiscard]] virtual size_t CountAwakeChunks() const noexcept { return 0; }
+
+protected:
+    SettledSnow(const int width, const int height, const std::uint64_t seed)
+        : width_(width),
+          height_(height),
+          wordsPerRow_((static_cast<size_t>(width) + 63) / 64),
+          rowVersion_(static_cast<size_t>(height), 0),
+          seed_(seed)
+    {
+    }
+
+    void MarkRowChanged(const int y) noexcept { ++rowVersion_[static_cast<size_t>(y)]; }
+    void MarkAllRowsChanged() noexcept {
+        for (std::uint32_t& version : rowVersion_) ++version;
+    }
+
+    int width_;
+    int height_;
+    size_t wordsPerRow_;
+    std::vector<std::uint32_t> rowVersion_;
+
+    // Keys for the counter-based draws of the settling rules
+    std::uint64_t seed_;
+    std::uint64_t passIndex_ = 0;
+};
+
+// Odds shared by the settling rules of every model, as fractions of 65536.
+// They reproduce the original per-pixel draws: GenerateInt(0, 10) <= 1 to
+// move at all and GenerateInt(0, 100) < 50 to try the left side first.
+namespace SnowRules {
+
+inline constexpr std::uint32_t ACTIVE_THRESHOLD = (65536u * 2u + 5u) / 11u;
+inline constexpr std::uint32_t LEFT_FIRST_THRESHOLD = (65536u * 50u + 50u) / 101u;
+
+// Same odds as GenerateInt(0, 100) < accumulationChance * 100
+[[nodiscard]] inline std::uint32_t AccumulateThreshold(const float accumulationChance) noexcept {
+    std::uint32_t outcomes = 0;
+    for (int k = 0; k <= 100; ++k) {
+        outcomes += static_cast<float>(k) < accumulationChance * 100 ? 1u : 0u;
+    }
+    return (65536u * outcomes + 50u) / 101u;
+}
+
+// Bits i of a word with i % 3 == k. Because 64 % 3 == 1, the phase of bit i
+// in word w is (w + i) % 3.
+inline constexpr std::uint64_t PHASE_BITS[3] = {
+    0x9249249249249249ull,
+    0x2492492492492492ull,
+    0x4924924924924924ull,
+};
+
+[[nodiscard]] constexpr std::uint64_t PhaseMask(const size_t wordIndex, const int phase) noexcept {
+    return PHASE_BITS[(phase + 3 - static_cast<int>(wordIndex % 3)) % 3];
+}
+
+} // namespace SnowRules
+
+} // namespace RainEngine
@@ -0,0 +1,235 @@
+#include "SettledSnowGeometry.h"
+
+#include <algorithm>
+#include <bit>
+
+#include "CounterRandom.h"
+#include "DrawRecorder.h"
+
+#ifdef _WIN32
+#include <d2d1.h>
+#endif
+
+namespace RainEngine {
+
+namespace {
+
+// Stream ids of the per-run texture draws
+constexpr std::uint64_t TEXTURE_HIGHLIGHTS = 0;
+constexpr std::uint64_t TEXTURE_SURFACE = 1;
+
+// Call fn(startX, endX) for every run of snow in a row of cells, left to
+// right. Bits past the width are zero, so a run never spills past the row.
+template <typename Fn>
+void ForEachRun(const std::vector<std::uint64_t>& row, const int width, Fn&& fn)
+{
+    int startX = -1;
+    for (size_t i = 0; i < row.size(); ++i)
+    {
+        const std::uint64_t word = row[i];
+        const int base = static_cast<int>(i) * 64;
+        int bit = 0;
+        while (bit < 64)
+        {
+            const std::uint64_t rest = ~std::uint64_t{0} << bit;
+            if (startX < 0)
+            {
+                const std::uint64_t snow = word & rest;
+                if (snow == 0) break;
+                bit = std::countr_zero(snow);
+                startX = base + bit;
+            }
+            else
+            {
+                const std::uint64_t air = ~word & rest;
+                if (air == 0) break;
+                bit = std::countr_zero(air);
+                fn(startX, base + bit - 1);
+                startX = -1;
+            }
+        }
+    }
+    if (startX >= 0)
+    {
+        fn(startX, width - 1);
+    }
+}
+
+} // namespace
+
+size_t SettledSnowGeometry::Update(const SettledSnow& snow, int topRow, const Rect& sceneRect, const float scaleFactor,
+                                   const int cellSize)
+{
+    if (static_cast<int>(rows_.size()) != snow.GetHeight() || sceneWidth_ != snow.GetWidth() ||
+        !(sceneRect_ == sceneRect) || scaleFactor_ != scaleFactor || cellSize_ != cellSize ||
+        seed_ != snow.GetSeed())
+    {
+        rows_.resize(static_cast<size_t>(snow.GetHeight()));
+        rowWords_.assign(snow.GetWordsPerRow(), 0);
+        Invalidate();
+        sceneWidth_ = snow.GetWidth();
+        sceneRect_ = sceneRect;
+        scaleFactor_ = scaleFactor;
+        cellSize_ = cellSize;
+        seed_ = snow.GetSeed();
+    }
+
+    size_t rebuilt = 0;
+    topRow = std::max(topRow, 0);
+    for (int y = snow.GetHeight() - 1; y >= topRow; --y)
+    {
+        RowGeometry& row = rows_[static_cast<size_t>(y)];
+        const std::uint32_t version = snow.GetRowVersion(y);
+        const std::uint32_t aboveVersion = y > 0 ? snow.GetRowVersion(y - 1) : 0;
+        const bool exposedTop = y > topRow;
+        if (row.Valid && row.Version == version && row.AboveVersion == aboveVersion &&
+            row.ExposedTop == exposedTop)
+        {
+            continue;
+        }
+
+        BuildRow(snow, y, exposedTop, row);
+        row.Version = version;
+        row.AboveVersion = aboveVersion;
+        row.ExposedTop = exposedTop;
+        row.Valid = true;
+        ++rebuilt;
+    }
+    return rebuilt;
+}
+
+void SettledSnowGeometry::Invalidate() noexcept
+{
+    for (RowGeometry& row : rows_)
+    {
+        row.Valid = false;
+    }
+}
+
+void SettledSnowGeometry::Release() noexcept
+{
+    rows_ = {};
+    rowWords_ = {};
+    sceneWidth_ = 0;
+}
+
+size_t SettledSnowGeometry::CountPrimitives(int topRow) const noexcept
+{
+    size_t count = 0;
+    for (size_t y = static_cast<size_t>(std::max(topRow, 0)); y < rows_.size(); ++y)
+    {
+        count += rows_[y].Rects.size() + rows_[y].Ellipses.size();
+    }
+    return count;
+}
+
+void SettledSnowGeometry::BuildRow(const SettledSnow& snow, const int y, const bool exposedTop, RowGeometry& out)
+{
+    out.Rects.clear();
+    out.Ellipses.clear();
+    snow.ReadRow(y, rowWords_.data());
+
+    // Cell centres in scene pixels; one-pixel cells sit on the pixel itself
+    const float cell = static_cast<float>(cellSize_);
+    const float centre = (cell - 1.0f) * 0.5f;
+    const float left = static_cast<float>(sceneRect_.left) + centre;
+    const float normY = static_cast<float>(y) * cell + static_cast<float>(sceneRect_.top) + centre;
+    const float halfWidth = std::max({scaleFactor_, 1.0f, cell * 0.5f}); // Rows must still meet
+    const auto cellX = [&](const int x) { return static_cast<float>(x) * cell + left; };
+    const auto addEllipse = [&](const int x, const float dy, const float radiusX, const float radiusY) {
+        out.Ellipses.push_back({{cellX(x), normY + dy}, radiusX * scaleFactor_, radiusY * scaleFactor_});
+    };
+
+    ForEachRun(rowWords_, sceneWidth_, [&](const int startX, const int endX) {
+        // Efficient rectangular run for the base snow layer
+        out.Rects.push_back({cellX(startX) - halfWidth, normY - halfWidth,
+                             cellX(endX) + halfWidth, normY + halfWidth});
+
+        // Texture draws are keyed on the run, so they only move when it changes
+        const std::uint64_t runKey = CounterRandom::Key(seed_, static_cast<std::uint64_t>(y),
+                                                        static_cast<std::uint64_t>(startX),
+                                                        static_cast<std::uint64_t>(endX));
+
+        const int runLength = endX - startX + 1;
+        if (runLength <= 3)
+        {
+            // Isolated cells and small clusters get a round clump each
+            for (int px = startX; px <= endX; ++px)
+            {
+                addEllipse(px, 0.0f, 1.5f, 1.5f);
+            }
+        }
+        else if (runLength > 8)
+        {
+            // Rounded ends on snow banks and drifts
+            addEllipse(startX, 0.0f, 2.0f, 2.0f);
+            addEllipse(endX, 0.0f, 2.0f, 2.0f);
+
+            // 1-2 mid-run highlights on very long stretches
+            if (runLength > 20)
+            {
+                const std::uint64_t key = CounterRandom::Key(runKey, TEXTURE_HIGHLIGHTS, 0);
+                const int numHighlights = 1 + (runLength > 40 ? 1 : 0);
+                for (int h = 0; h < numHighlights; ++h)
+                {
+                    addEllipse(startX + CounterRandom::Int(key, 3, runLength - 3, static_cast<std::uint64_t>(h)),
+                               0.0f, 1.8f, 1.8f);
+                }
+            }
+        }
+
+        // Exposed top surfaces (air above the run start) get small bumps every few cells
+        if (exposedTop && snow.IsAir(startX, y - 1))
+        {
+            const std::uint64_t key = CounterRandom::Key(runKey, TEXTURE_SURFACE, 0);
+            std::uint64_t draw = 0;
+            for (int sx = startX; sx <= endX; sx += 2 + CounterRandom::Int(key, 0, 3, draw++))
+            {
+                if (CounterRandom::Int(key, 0, 100, draw++) < 30) // 30% chance for surface detail
+                {
+                    addEllipse(sx, -0.5f, 1.2f, 0.8f);
+                }
+            }
+        }
+    });
+}
+
+void SettledSnowGeometry::Record(DrawRecorder& recorder, int topRow) const
+{
+    topRow = std::max(topRow, 0);
+    for (int y = static_cast<int>(rows_.size()) - 1; y >= topRow; --y)
+    {
+        const RowGeometry& row = rows_[static_cast<size_t>(y)];
+        for (const RectF& rect : row.Rects)
+        {
+            recorder.FillRect({rect.left, rect.top}, {rect.right, rect.bottom});
+        }
+        for (const EllipseF& ellipse : row.Ellipses)
+        {
+            recorder.FillEllipse(ellipse.center, ellipse.radiusX, ellipse.radiusY);
+        }
+    }
+}
+
+#ifdef _WIN32
+void SettledSnowGeometry::Draw(ID2D1DeviceContext* dc, ID2D1Brush* brush, int topRow) const noexcept
+{
+    // Bottom-up, the order the rows were always drawn in
+    topRow = std::max(topRow, 0);
+    for (int y = static_cast<int>(rows_.size()) - 1; y >= topRow; --y)
+    {
+        const RowGeometry& row = rows_[static_cast<size_t>(y)];
+        for (const RectF& rect : row.Rects)
+        {
+            dc->FillRectangle(D2D1::RectF(rect.left, rect.top, rect.right, rect.bottom), brush);
+        }
+        for (const EllipseF& ellipse : row.Ellipses)
+        {
+            dc->FillEllipse(D2D1::Ellipse(D2D1::Point2F(ellipse.center.x, ellipse.center.y),
+                                          ellipse.radiusX, ellipse.radiusY), brush);
+        }
+    }
+}
+#endif
+
+} // namespace RainEngine
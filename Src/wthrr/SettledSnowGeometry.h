@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "CoreTypes.h"
+#include "SettledSnow.h"
+
+// Forward declarations to keep Direct2D out of the simulation core
+struct ID2D1DeviceContext;
+struct ID2D1Brush;
+
+namespace RainEngine {
+
+class DrawRecorder;
+
+// Draw-ready shapes of the settled snow layer, cached per scene row.
+//
+// Each row of snow becomes one rectangle per horizontal run plus a few
+// ellipses for texture (short clumps, run ends, highlights, surface bumps).
+// A row's shapes depend only on that row, the row above it and whether the
+// row lies below the snow ceiling, so Update rebuilds just the rows whose
+// change counters moved. Highlight and bump positions are drawn from
+// counter-based randoms keyed on the run, so they stay put from frame to
+// frame for as long as the run itself does not change.
+class SettledSnowGeometry {
+public:
+    struct RectF {
+        float left = 0.0f;
+        float top = 0.0f;
+        float right = 0.0f;
+        float bottom = 0.0f;
+    };
+
+    struct EllipseF {
+        PointF center;
+        float radiusX = 0.0f;
+        float radiusY = 0.0f;
+    };
+
+    SettledSnowGeometry() noexcept = default;
+
+    // Bring rows [topRow, snow height) up to date with the snow and return
+    // the number of rows rebuilt. sceneRect places the cells on screen, each
+    // cellSize scene pixels square.
+    size_t Update(const SettledSnow& snow, int topRow, const Rect& sceneRect, float scaleFactor, int cellSize = 1);
+
+    // Forget every cached row, e.g. after the snow was replaced
+    void Invalidate() noexcept;
+
+    // Free every cached row; the next Update rebuilds from scratch
+    void Release() noexcept;
+
+    [[nodiscard]] int GetRowCount() const noexcept { return static_cast<int>(rows_.size()); }
+    [[nodiscard]] const std::vector<RectF>& GetRects(int y) const noexcept { return rows_[static_cast<size_t>(y)].Rects; }
+    [[nodiscard]] const std::vector<EllipseF>& GetEllipses(int y) const noexcept { return rows_[static_cast<size_t>(y)].Ellipses; }
+
+    // Total shapes in rows [topRow, row count)
+    [[nodiscard]] size_t CountPrimitives(int topRow) const noexcept;
+
+    // The cached shapes of rows [topRow, row count), bottom-up, as Draw issues them
+    void Record(DrawRecorder& recorder, int topRow) const;
+    void Draw(ID2D1DeviceContext* dc, ID2D1Brush* brush, int topRow) const noexcept;
+
+private:
+    struct RowGeometry {
+        std::vector<RectF> Rects;
+        std::vector<EllipseF> Ellipses;
+        std::uint32_t Version = 0;       // Change counter of this row when built
+        std::uint32_t AboveVersion = 0;  // Change counter of the row above when built
+        bool ExposedTop = false;         // Row was below the snow ceiling when built
+        bool Valid = false;
+    };
+
+    std::vector<RowGeometry> rows_;
+    std::vector<std::uint64_t> rowWords_; // One row of cells, read for a rebuild
+
+    // Inputs every row was built with; a change invalidates the whole cache
+    int sceneWidth_ = 0;
+    Rect sceneRect_{};
+    float scaleFactor_ = 0.0f;
+    int cellSize_ = 1;
+    std::uint64_t seed_ = 0;
+
+    void BuildRow(const SettledSnow& snow, int y, bool exposedTop, RowGeometry& out);
+};
+
+} // namespace RainEngine
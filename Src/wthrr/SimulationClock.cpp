@@ -0,0 +1,57 @@
+#include "SimulationClock.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace RainEngine {
+
+SimulationClock::SimulationClock(const double stepSeconds) noexcept
+    : stepSeconds_(stepSeconds > 0.0 ? stepSeconds : DEFAULT_STEP_SECONDS)
+{
+}
+
+int SimulationClock::BeginFrame(const double wallSeconds) noexcept
+{
+    frameStartStep_ = stepCount_;
+    frameSteps_ = 0;
+
+    if (!paused_)
+    {
+        accumulator_ += std::clamp(wallSeconds, 0.0, MAX_FRAME_TIME) * timeScale_;
+    }
+
+    // Update with a fixed time step for physics stability, limiting the steps per frame
+    while (accumulator_ >= stepSeconds_ && frameSteps_ < maxStepsPerFrame_)
+    {
+        accumulator_ -= stepSeconds_;
+        ++frameSteps_;
+    }
+
+    // A backlog the step cap cannot work off is dropped, not carried forever
+    accumulator_ = std::min(accumulator_, MAX_FRAME_TIME);
+
+    // Fast-forward steps run on top of the normal ones
+    const int fastForwardSteps = static_cast<int>(
+        std::min<std::uint64_t>(fastForwardSteps_, FAST_FORWARD_STEPS_PER_FRAME));
+    fastForwardSteps_ -= static_cast<std::uint64_t>(fastForwardSteps);
+    frameSteps_ += fastForwardSteps;
+
+    stepCount_ += static_cast<std::uint64_t>(frameSteps_);
+    return frameSteps_;
+}
+
+void SimulationClock::SetTimeScale(const double scale) noexcept
+{
+    timeScale_ = std::max(scale, 0.0);
+}
+
+void SimulationClock::FastForward(const double seconds) noexcept
+{
+    // Whole steps, rounded, so a fast-forward of n steps' time runs exactly n
+    if (seconds > 0.0)
+    {
+        fastForwardSteps_ += static_cast<std::uint64_t>(std::llround(seconds / stepSeconds_));
+    }
+}
+
+} // namespace RainEngine
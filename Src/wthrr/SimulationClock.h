@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+
+namespace RainEngine {
+
+// Simulation time for the fixed-step update, owned by the frame loop.
+//
+// Each frame, BeginFrame banks the frame's wall time (capped, then scaled)
+// and pays out as many whole fixed steps as are due, up to a per-frame cap.
+// Every simulation driven that frame runs the same steps and reads their
+// times from here, so timers such as lightning and snow wind move with the
+// physics, including catch-up steps, and never read a wall clock.
+// Pausing stops banking wall time; FastForward queues simulation time that
+// runs in extra steps on top of the normal ones.
+class SimulationClock {
+public:
+    // Target a stable physics time step of 1/120th of a second
+    static constexpr double DEFAULT_STEP_SECONDS = 1.0 / 120.0;
+    static constexpr int DEFAULT_MAX_STEPS_PER_FRAME = 3;
+    // Cap maximum frame time to avoid "spiral of death" with very long frames
+    static constexpr double MAX_FRAME_TIME = 0.25;
+    // Extra steps per frame while fast-forwarding
+    static constexpr int FAST_FORWARD_STEPS_PER_FRAME = 24;
+
+    explicit SimulationClock(double stepSeconds = DEFAULT_STEP_SECONDS) noexcept;
+
+    // Bank wallSeconds of frame time and decide this frame's steps.
+    // Returns the number of steps due.
+    int BeginFrame(double wallSeconds) noexcept;
+
+    // Steps due this frame, the number of each among all steps (from 1),
+    // and the simulation time at the end of each
+    [[nodiscard]] int GetFrameSteps() const noexcept { return frameSteps_; }
+    [[nodiscard]] std::uint64_t GetStepIndex(int step) const noexcept {
+        return frameStartStep_ + static_cast<std::uint64_t>(step) + 1;
+    }
+    [[nodiscard]] double GetStepTime(int step) const noexcept {
+        return static_cast<double>(GetStepIndex(step)) * stepSeconds_;
+    }
+
+    [[nodiscard]] float GetStepSeconds() const noexcept { return static_cast<float>(stepSeconds_); }
+    [[nodiscard]] std::uint64_t GetStepCount() const noexcept { return stepCount_; }
+
+    // Simulation seconds after every step handed out so far
+    [[nodiscard]] double Now() const noexcept { return static_cast<double>(stepCount_) * stepSeconds_; }
+
+    // Simulation seconds per wall second; 0 stops time like Pause. Speeds
+    // above what the step cap allows run at the cap; at most MAX_FRAME_TIME
+    // of backlog is kept.
+    void SetTimeScale(double scale) noexcept;
+    [[nodiscard]] double GetTimeScale() const noexcept { return timeScale_; }
+
+    void SetPaused(bool paused) noexcept { paused_ = paused; }
+    [[nodiscard]] bool IsPaused() const noexcept { return paused_; }
+
+    // Run seconds of simulation as fast as the fast-forward cap allows.
+    // Runs while paused too.
+    void FastForward(double seconds) noexcept;
+    [[nodiscard]] double GetFastForwardRemaining() const noexcept {
+        return static_cast<double>(fastForwardSteps_) * stepSeconds_;
+    }
+
+    void SetMaxStepsPerFrame(int steps) noexcept { maxStepsPerFrame_ = steps > 0 ? steps : 1; }
+    [[nodiscard]] int GetMaxStepsPerFrame() const noexcept { return maxStepsPerFrame_; }
+
+private:
+    double stepSeconds_;
+    double accumulator_ = 0.0;  // Banked scaled time not yet stepped
+    double timeScale_ = 1.0;
+    bool paused_ = false;
+    int maxStepsPerFrame_ = DEFAULT_MAX_STEPS_PER_FRAME;
+
+    std::uint64_t stepCount_ = 0;      // Steps handed out, including this frame's
+    std::uint64_t frameStartStep_ = 0; // Steps handed out before this frame
+    std::uint64_t fastForwardSteps_ = 0; // Queued fast-forward steps not yet run
+    int frameSteps_ = 0;
+};
+
+} // namespace RainEngine
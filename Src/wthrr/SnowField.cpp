@@ -0,0 +1,619 @@
+#include "SnowField.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "DrawRecorder.h"
+#include "FastNoiseLite.h"
+#include "MathUtil.h"
+#include "RandomGenerator.h"
+
+namespace RainEngine {
+
+namespace {
+
+constexpr int EVENT_NONE = 0;
+constexpr int EVENT_RESPAWN = 1;
+constexpr int EVENT_SETTLE = 2;
+
+// sin(2 pi turns) for |turns| < 64, within 4e-6. The argument is folded into
+// [-1/4, 1/4] turn with selects and a truncating conversion, then fed to a
+// degree 9 odd polynomial, so a loop over it vectorizes on plain SSE2.
+[[nodiscard]] inline float SinTurns(const float turns) noexcept
+{
+    const float nearest = static_cast<float>(static_cast<int>(turns + 64.5f)) - 64.0f;
+    float r = turns - nearest;
+    const float above = 0.5f - r;
+    const float below = -0.5f - r;
+    r = r > 0.25f ? above : r;
+    r = r < -0.25f ? below : r;
+    const float x = r * 6.28318530718f;
+    const float x2 = x * x;
+    return x * (1.0f + x2 * (-1.0f / 6.0f + x2 * (1.0f / 120.0f + x2 * (-1.0f / 5040.0f + x2 * (1.0f / 362880.0f)))));
+}
+
+[[nodiscard]] inline float CosTurns(const float turns) noexcept
+{
+    return SinTurns(turns + 0.25f);
+}
+
+} // namespace
+
+SnowField::SnowField(DisplayData* pDispData) noexcept
+    : pDisplayData(pDispData)
+{
+}
+
+void SnowField::Reserve(size_t capacity)
+{
+    capacity = (capacity + LANES - 1) / LANES * LANES;
+    for (auto* column : { &PosX, &PosY, &VelX, &VelY, &FlakeSize, &Rotation, &RotationSpeed, &Opacity,
+                          &WobblePhase, &WobbleAmplitude, &WindResistance, &Turbulence })
+    {
+        column->reserve(capacity);
+    }
+    Shape.reserve(capacity);
+}
+
+void SnowField::Resize(const size_t count)
+{
+    const size_t padded = (count + LANES - 1) / LANES * LANES;
+    for (auto* column : { &PosX, &PosY, &VelX, &VelY, &Rotation, &RotationSpeed, &Opacity,
+                          &WobblePhase, &WobbleAmplitude, &WindResistance, &Turbulence })
+    {
+        column->resize(padded, 0.0f);
+    }
+    FlakeSize.resize(padded, 1.0f);
+    Shape.resize(padded, SHAPE_SIMPLE);
+    Count = count;
+}
+
+void SnowField::Truncate(const size_t count) noexcept
+{
+    if (count < Count)
+    {
+        Resize(count); // Shrinking never allocates
+    }
+}
+
+void SnowField::Clear() noexcept
+{
+    for (auto* column : { &PosX, &PosY, &VelX, &VelY, &FlakeSize, &Rotation, &RotationSpeed, &Opacity,
+                          &WobblePhase, &WobbleAmplitude, &WindResistance, &Turbulence })
+    {
+        *column = {};
+    }
+    Shape = {};
+    Flow.Release();
+    RespawnEvents = {};
+    SettleEvents = {};
+    Respawns = {};
+    Count = 0;
+}
+
+struct SnowField::SpawnBlock
+{
+    static constexpr size_t SIZE = 64;
+
+    float PosX[SIZE];
+    float PosY[SIZE];
+    float VelX[SIZE];
+    float VelY[SIZE];
+    float FlakeSize[SIZE];
+    float Rotation[SIZE];
+    float RotationSpeed[SIZE];
+    float Opacity[SIZE];
+    float WobblePhase[SIZE];
+    float WobbleAmplitude[SIZE];
+    int Shape[SIZE];
+};
+
+void SnowField::Spawn(const int count)
+{
+    if (count <= 0) return;
+
+    const size_t first = Count;
+    const size_t total = static_cast<size_t>(count);
+    Resize(Count + total);
+
+    SpawnBlock block;
+    for (size_t done = 0; done < total; done += SpawnBlock::SIZE)
+    {
+        const size_t n = std::min(SpawnBlock::SIZE, total - done);
+        DrawSpawnBlock(block, n, false);
+        for (size_t j = 0; j < n; ++j)
+        {
+            StoreSpawn(block, j, first + done + j);
+        }
+    }
+}
+
+void SnowField::RespawnFlakes(const std::vector<std::uint32_t>& indices)
+{
+    SpawnBlock block;
+    for (size_t done = 0; done < indices.size(); done += SpawnBlock::SIZE)
+    {
+        const size_t n = std::min(SpawnBlock::SIZE, indices.size() - done);
+        DrawSpawnBlock(block, n, true);
+        for (size_t j = 0; j < n; ++j)
+        {
+            StoreSpawn(block, j, indices[done + j]);
+        }
+    }
+}
+
+void SnowField::DrawSpawnBlock(SpawnBlock& block, const size_t count, const bool aboveScene) const
+{
+    auto& rng = RandomGenerator::GetInstance();
+    const float width = static_cast<float>(pDisplayData->Width);
+    const float height = static_cast<float>(pDisplayData->Height);
+
+    // Position randomization: new flakes scatter over and above the scene,
+    // respawned ones start just above it
+    rng.FillFloat(block.PosX, count, -width * 0.5f, width * 1.5f);
+    if (aboveScene)
+    {
+        std::fill_n(block.PosY, count, -5.0f);
+    }
+    else
+    {
+        rng.FillFloat(block.PosY, count, -height * 0.5f, height);
+    }
+
+    // Velocity randomization - more moderate values for smoother movement
+    rng.FillFloat(block.VelX, count, -10.0f, 10.0f); // Reduced horizontal velocity variation
+    rng.FillFloat(block.VelY, count, 20.0f, 50.0f); // More moderate vertical speed range
+
+    // Visual properties
+    rng.FillFloat(block.FlakeSize, count, 0.5f, 1.3f); // 0.5 to 1.3 base size
+    rng.FillFloat(block.Rotation, count, 0.0f, TWO_PI); // Random initial rotation (in radians)
+    rng.FillFloat(block.RotationSpeed, count, -0.2f, 0.2f); // Reduced rotation speed
+    rng.FillFloat(block.Opacity, count, 0.5f, 1.0f); // 0.5 to 1.0 opacity
+
+    // Wobble effect
+    rng.FillFloat(block.WobblePhase, count, 0.0f, TWO_PI);
+    rng.FillFloat(block.WobbleAmplitude, count, 0.2f * MAX_WOBBLE, MAX_WOBBLE); // Smoother wobble variation
+
+    rng.FillInt(block.Shape, count, 0, 100);
+}
+
+void SnowField::StoreSpawn(const SpawnBlock& block, const size_t slot, const size_t index)
+{
+    PosX[index] = block.PosX[slot];
+    PosY[index] = block.PosY[slot];
+    VelX[index] = block.VelX[slot];
+    VelY[index] = block.VelY[slot];
+    FlakeSize[index] = block.FlakeSize[slot];
+    Rotation[index] = block.Rotation[slot];
+    RotationSpeed[index] = block.RotationSpeed[slot];
+    Opacity[index] = block.Opacity[slot];
+    WobblePhase[index] = block.WobblePhase[slot];
+    WobbleAmplitude[index] = block.WobbleAmplitude[slot];
+
+    // Wind resistance based on size (smaller flakes are more affected by wind)
+    WindResistance[index] = WIND_RESISTANCE * (1.8f - FlakeSize[index]); // Adjusted for smoother transitions
+
+    // Randomly choose a snowflake shape
+    const int shapeType = block.Shape[slot];
+    if (shapeType < 40) {
+        Shape[index] = SHAPE_SIMPLE; // 40% simple shapes
+    } else if (shapeType < 70) {
+        Shape[index] = SHAPE_CRYSTAL; // 30% crystals
+    } else if (shapeType < 90) {
+        Shape[index] = SHAPE_HEXAGON; // 20% hexagons
+    } else {
+        Shape[index] = SHAPE_STAR; // 10% stars
+    }
+}
+
+void SnowField::ApplyWind(const float windFactor, const float deltaSeconds) noexcept
+{
+    // Wind changes the wobble of every flake alike when it is strong
+    const bool strongWind = std::fabs(windFactor) > 1.0f;
+    const float wobbleGain = std::fabs(windFactor) * 0.05f * deltaSeconds;
+
+    // Blocks of LANES flakes go through locals, like the update kernel
+    for (size_t base = 0; base < PaddedSize(); base += LANES)
+    {
+        const float* flakeSizes = FlakeSize.data() + base;
+        const float* windResistances = WindResistance.data() + base;
+        float* velXs = VelX.data() + base;
+        float* rotationSpeeds = RotationSpeed.data() + base;
+        float* wobbleAmplitudes = WobbleAmplitude.data() + base;
+
+        float velX[LANES], rotationSpeed[LANES], wobbleAmplitude[LANES];
+        for (size_t l = 0; l < LANES; ++l)
+        {
+            // Apply wind effect to the snowflake with stronger and more visible transitions
+            const float windForce = windFactor * windResistances[l] * 12.0f * deltaSeconds;
+            const float vx = velXs[l] + windForce;
+
+            // Cap the maximum wind-induced velocity with smoother capping, scaled by size
+            // (both sides are computed up front so the loop stays branch-free)
+            const float maxWindSpeed = MAX_WIND_SPEED * flakeSizes[l];
+            const float overTop = vx * 0.9f + maxWindSpeed * 0.1f;
+            const float overBottom = vx * 0.9f - maxWindSpeed * 0.1f;
+            velX[l] = vx > maxWindSpeed ? overTop : vx < -maxWindSpeed ? overBottom : vx;
+
+            // Wind affects rotation more dramatically to make it more visible
+            rotationSpeed[l] = rotationSpeeds[l] + windForce * 0.015f * (1.0f / flakeSizes[l]);
+
+            const float wobble = std::min(wobbleAmplitudes[l] + wobbleGain, MAX_WOBBLE * 1.5f);
+            wobbleAmplitude[l] = strongWind ? wobble : wobbleAmplitudes[l];
+        }
+
+        std::copy(velX, velX + LANES, velXs);
+        std::copy(rotationSpeed, rotationSpeed + LANES, rotationSpeeds);
+        std::copy(wobbleAmplitude, wobbleAmplitude + LANES, wobbleAmplitudes);
+    }
+}
+
+void SnowField::SampleTurbulence(const float deltaSeconds)
+{
+    // The flow field spans every position a live flake can have, with cells
+    // that grow with the display so every resolution takes as many samples
+    const int width = pDisplayData->Width;
+    const int height = pDisplayData->Height;
+    const int cellSize = std::max(1, static_cast<int>(std::lround(FlowField::BASE_CELL_SIZE * pDisplayData->ScaleFactor)));
+    if (Flow.GetWidth() != width * 2 || Flow.GetHeight() != height + height / 2 || Flow.GetCellSize() != cellSize)
+    {
+        Flow.Configure(-width * 0.5f, -height * 0.5f, width * 2, height + height / 2, cellSize, NOISE_SCALE,
+                       FLOW_SLICE_SECONDS * NOISE_CLOCK_RATE * NOISE_TIMESCALE);
+    }
+
+    NoiseTime += deltaSeconds * NOISE_CLOCK_RATE;
+    Flow.Advance(*pDisplayData->pNoiseGen, NoiseTime * NOISE_TIMESCALE);
+
+    // One batch for the whole field, at the positions the flakes start the step from
+    for (size_t i = 0; i < Count; ++i)
+    {
+        Turbulence[i] = Flow.Sample(PosX[i], PosY[i]);
+    }
+    std::fill(Turbulence.begin() + static_cast<std::ptrdiff_t>(Count), Turbulence.end(), 0.0f);
+}
+
+void SnowField::Update(const float deltaSeconds)
+{
+    RespawnEvents.clear();
+    SettleEvents.clear();
+    if (Count == 0) return;
+
+    // Padding lanes run through the kernel too; park them where nothing happens
+    for (size_t i = Count; i < PaddedSize(); ++i)
+    {
+        PosX[i] = 0.0f;
+        PosY[i] = 0.0f;
+        VelX[i] = 0.0f;
+        VelY[i] = 0.0f;
+    }
+
+    SampleTurbulence(deltaSeconds);
+
+    const float width = static_cast<float>(pDisplayData->Width);
+    const float height = static_cast<float>(pDisplayData->Height);
+    const int sceneWidth = pDisplayData->Width;
+    const int sceneHeight = pDisplayData->Height;
+
+    // Snow never sits above row MaxSnowHeight - 1 (accumulation may grow
+    // one row past the settling ceiling), so a flake can only touch it from
+    // row MaxSnowHeight - 2 down
+    const int snowLineY = (pDisplayData->MaxSnowHeight - 2) * pDisplayData->SnowCellSize;
+
+    // Every block of LANES flakes is advanced into locals first; the fixed
+    // trip count and the lack of aliasing let the compiler keep it in vectors
+    for (size_t base = 0; base < PaddedSize(); base += LANES)
+    {
+        const float* rotationSpeeds = RotationSpeed.data() + base;
+        const float* wobbleAmplitudes = WobbleAmplitude.data() + base;
+        const float* turbulence = Turbulence.data() + base;
+        float* posXs = PosX.data() + base;
+        float* posYs = PosY.data() + base;
+        float* velXs = VelX.data() + base;
+        float* velYs = VelY.data() + base;
+        float* rotations = Rotation.data() + base;
+        float* wobblePhases = WobblePhase.data() + base;
+
+        float posX[LANES], posY[LANES], velX[LANES], velY[LANES], rotation[LANES], phase[LANES];
+        int event[LANES]; // Lane-wide, so the flags share vectors with the floats
+
+        for (size_t l = 0; l < LANES; ++l)
+        {
+            // Update rotation and wobble phase with proper delta time
+            rotation[l] = rotations[l] + rotationSpeeds[l] * deltaSeconds;
+            const float wobblePhase = wobblePhases[l] + deltaSeconds;
+            const float wrappedPhase = wobblePhase - TWO_PI;
+            phase[l] = wobblePhase > TWO_PI ? wrappedPhase : wobblePhase;
+
+            // Noise steers the flake along angle = noise * 2 pi + pi / 2
+            const float cosAngle = -SinTurns(turbulence[l]);
+            const float sinAngle = CosTurns(turbulence[l]);
+
+            // Add wobble effect to horizontal movement - with stronger effect when velocity is higher
+            float vx = velXs[l];
+            float vy = velYs[l];
+            const float velocityFactor = std::min((vx * vx + vy * vy) / 1000.0f, 1.0f);
+            const float wobbleEffect = SinTurns(phase[l] * (1.0f / TWO_PI)) * wobbleAmplitudes[l] *
+                                       (1.0f + velocityFactor);
+
+            // Apply noise, wobble and gravity with proper delta time scaling
+            vx += (cosAngle * NOISE_INTENSITY * deltaSeconds) + (wobbleEffect * deltaSeconds);
+            vy += sinAngle * NOISE_INTENSITY * deltaSeconds;
+            vy += GRAVITY * deltaSeconds;
+
+            // Apply less horizontal damping when velocity is high (makes wind effects more visible)
+            const float dampingFactor = velocityFactor > 0.5f ? 0.005f : 0.01f;
+            vx *= (1.0f - (dampingFactor * deltaSeconds * 100.0f));
+
+            // Cap maximum velocity, but allow higher speeds for more dynamic wind effects
+            // (the scale is computed for every lane and selected, keeping the lanes in step)
+            const float speedSquared = vx * vx + vy * vy;
+            const float cappedScale = MAX_SPEED / std::sqrt(std::max(speedSquared, 1.0f));
+            const float speedScale = speedSquared > MAX_SPEED * MAX_SPEED ? cappedScale : 1.0f;
+            vx *= speedScale;
+            vy *= speedScale;
+            velX[l] = vx;
+            velY[l] = vy;
+
+            // Update position with proper delta time
+            const float x = posXs[l] + vx * deltaSeconds;
+            const float y = posYs[l] + vy * deltaSeconds;
+            posX[l] = x;
+            posY[l] = y;
+
+            // Leaving the scene respawns the flake; in-scene flakes at the snow line may settle
+            // (bitwise operators keep the lanes free of branches)
+            const int outside = (x < -width * 0.5f) | (x >= width * 1.5f) | (y < -height * 0.5f) | (y >= height);
+            const int pixelX = static_cast<int>(x);
+            const int pixelY = static_cast<int>(y);
+            const int nearSnow = (pixelX >= 0) & (pixelX < sceneWidth) & (pixelY >= snowLineY) & (pixelY < sceneHeight);
+            event[l] = outside * EVENT_RESPAWN + (nearSnow & ~outside) * EVENT_SETTLE;
+        }
+
+        std::copy(posX, posX + LANES, posXs);
+        std::copy(posY, posY + LANES, posYs);
+        std::copy(velX, velX + LANES, velXs);
+        std::copy(velY, velY + LANES, velYs);
+        std::copy(rotation, rotation + LANES, rotations);
+        std::copy(phase, phase + LANES, wobblePhases);
+
+        // Scalar pass over the rare flakes the kernel flagged
+        for (size_t l = 0; l < LANES; ++l)
+        {
+            if (event[l] == EVENT_NONE || base + l >= Count) continue;
+            (event[l] == EVENT_RESPAWN ? RespawnEvents : SettleEvents).push_back(static_cast<std::uint32_t>(base + l));
+        }
+    }
+
+    // Flakes that fell out through the bottom of the scene land on the floor
+    SettledSnow& snow = *pDisplayData->pSettledSnow;
+    for (const std::uint32_t i : RespawnEvents)
+    {
+        if (PosX[i] >= 0 && PosX[i] < width && PosY[i] >= height)
+        {
+            snow.SetSnow(static_cast<int>(PosX[i]) / pDisplayData->SnowCellSize, snow.GetHeight() - 1);
+        }
+    }
+    Respawns.assign(RespawnEvents.begin(), RespawnEvents.end());
+
+    for (const std::uint32_t i : SettleEvents)
+    {
+        if (SettleFlake(i))
+        {
+            Respawns.push_back(i);
+        }
+    }
+
+    // Every flake that left the scene or landed starts over, in one batch
+    RespawnFlakes(Respawns);
+}
+
+bool SnowField::SettleFlake(const size_t index)
+{
+    // If any of our neighboring cells are filled, settle here
+    SettledSnow& snow = *pDisplayData->pSettledSnow;
+    const int x = static_cast<int>(PosX[index]) / pDisplayData->SnowCellSize;
+    const int y = static_cast<int>(PosY[index]) / pDisplayData->SnowCellSize;
+    for (int xOff = -1; xOff <= 1; ++xOff)
+    {
+        for (int yOff = -1; yOff <= 1; ++yOff)
+        {
+            if (snow.IsSnow(x + xOff, y + yOff)) // Out-of-bounds is never snow
+            {
+                if (snow.IsAir(x, y))
+                {
+                    // Only settle if the cell is empty
+                    snow.SetSnow(x, y);
+                    if (y < pDisplayData->MaxSnowHeight)
+                    {
+                        pDisplayData->MaxSnowHeight = y;
+                        pDisplayData->SetMaxSnowHeight(y);
+                    }
+                }
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void SnowField::Record(DrawRecorder& recorder) const
+{
+    for (size_t index = 0; index < Count; ++index)
+    {
+        RecordFlake(recorder, index);
+    }
+}
+
+#ifdef _WIN32
+void SnowField::Draw(ID2D1DeviceContext* dc) const
+{
+    DrawRecorder& commands = pDisplayData->GetDrawCommands();
+    commands.Clear();
+    Record(commands);
+    commands.Replay(dc, *pDisplayData);
+}
+#endif
+
+void SnowField::RecordFlake(DrawRecorder& recorder, const size_t index) const
+{
+    if (!MathUtil::IsPointInRect(pDisplayData->SceneRectNorm, GetPosition(index)))
+    {
+        return;
+    }
+
+    // Calculate the drawing position
+    const PointF center{PosX[index] + static_cast<float>(pDisplayData->SceneRect.left),
+                        PosY[index] + static_cast<float>(pDisplayData->SceneRect.top)};
+
+    // Scale the size based on the display scale factor
+    const float drawSize = FlakeSize[index] * pDisplayData->ScaleFactor;
+
+    // Draw wind motion trails for snowflakes with high horizontal velocity
+    // This creates a visible indication of wind direction
+    const float velX = VelX[index];
+    if (std::fabs(velX) > 30.0f)
+    {
+        const float baseOpacity = Opacity[index]; // Apply snowflake's opacity
+
+        // Calculate trail length based on velocity - makes wind speed visibly apparent
+        const float trailLength = std::min(std::fabs(velX) * 0.15f, 10.0f);
+
+        // Determine trail direction (opposite of movement direction)
+        const float trailDir = velX > 0 ? -1.0f : 1.0f;
+
+        // Create a trail with fading opacity
+        for (int i = 1; i <= 3; i++)
+        {
+            // Calculate trail segment position, with a slight upward curve
+            const float trailDist = i * (trailLength / 3.0f);
+            const PointF trailPoint{center.x + trailDir * trailDist, center.y - (i * 0.5f)};
+
+            // Draw small trail point
+            const float trailSize = drawSize * (0.8f - (i * 0.2f));
+            recorder.FillEllipse(trailPoint, trailSize, trailSize, baseOpacity * (0.5f - (i * 0.15f)));
+        }
+    }
+
+    // Draw different snowflake shapes based on the shape type
+    switch (Shape[index])
+    {
+    case SHAPE_SIMPLE:
+        RecordSimpleSnowflake(recorder, center, drawSize, Rotation[index]);
+        break;
+    case SHAPE_CRYSTAL:
+        RecordCrystalSnowflake(recorder, center, drawSize, Rotation[index]);
+        break;
+    case SHAPE_HEXAGON:
+        RecordHexagonSnowflake(recorder, center, drawSize, Rotation[index]);
+        break;
+    case SHAPE_STAR:
+        RecordStarSnowflake(recorder, center, drawSize, Rotation[index]);
+        break;
+    default:
+        break;
+    }
+}
+
+// The shapes are turned by rotation about their centre: the ellipse through
+// its command, the lines by adding rotation to the angle of every point
+
+void SnowField::RecordSimpleSnowflake(DrawRecorder& recorder, const PointF center, const float size,
+                                      const float rotation)
+{
+    // For simple snowflakes, just draw an ellipse with slight variations
+    recorder.FillEllipse(center, 1.0f * size, 0.7f * size, 1.0f, rotation);
+}
+
+void SnowField::RecordCrystalSnowflake(DrawRecorder& recorder, const PointF center, const float size,
+                                       const float rotation)
+{
+    // Draw a small center circle
+    recorder.FillEllipse(center, size * 0.5f, size * 0.5f);
+
+    // Draw 6 arms for the crystal (60 degrees apart)
+    const int numArms = 6;
+    const float baseLength = size * 2.0f;
+    const float branchLength = baseLength * 0.4f;
+    const float branchAngleOffset = 30.0f * (PI / 180.0f); // 30 degrees
+
+    for (int i = 0; i < numArms; i++)
+    {
+        const float angle = (i * TWO_PI) / numArms + rotation;
+
+        // Draw the main arm
+        const PointF endPoint{center.x + std::cos(angle) * baseLength, center.y + std::sin(angle) * baseLength};
+        recorder.Line(center, endPoint, size * 0.2f);
+
+        // Draw small branches (2 per arm)
+        const PointF midPoint{center.x + std::cos(angle) * baseLength * 0.6f,
+                              center.y + std::sin(angle) * baseLength * 0.6f};
+        for (const float branchAngle : { angle + branchAngleOffset, angle - branchAngleOffset })
+        {
+            const PointF branchEnd{midPoint.x + std::cos(branchAngle) * branchLength,
+                                   midPoint.y + std::sin(branchAngle) * branchLength};
+            recorder.Line(midPoint, branchEnd, size * 0.15f);
+        }
+    }
+}
+
+void SnowField::RecordHexagonSnowflake(DrawRecorder& recorder, const PointF center, const float size,
+                                       const float rotation)
+{
+    // Draw a hexagon shape using lines
+    constexpr int sides = 6;
+    const float radius = size * 2.0f;
+
+    PointF points[sides + 1];
+    for (int i = 0; i <= sides; ++i)
+    {
+        const float angle = i * TWO_PI / sides + rotation;
+        points[i] = {center.x + radius * std::cos(angle), center.y + radius * std::sin(angle)};
+    }
+
+    // Draw the hexagon outline
+    for (int i = 0; i < sides; ++i)
+    {
+        recorder.Line(points[i], points[i + 1], size * 0.2f);
+    }
+
+    // Draw inner details (spokes from the center to each vertex)
+    for (int i = 0; i < sides; ++i)
+    {
+        recorder.Line(center, points[i], size * 0.15f);
+    }
+
+    // Draw center circle
+    recorder.FillEllipse(center, size * 0.4f, size * 0.4f);
+}
+
+void SnowField::RecordStarSnowflake(DrawRecorder& recorder, const PointF center, const float size,
+                                    const float rotation)
+{
+    // Draw a small center circle
+    recorder.FillEllipse(center, size * 0.4f, size * 0.4f);
+
+    // Draw a star pattern with 12 spikes
+    const int numSpikes = 12;
+    const float outerRadius = size * 2.5f;
+    const float innerRadius = size * 1.0f;
+
+    for (int i = 0; i < numSpikes; i++)
+    {
+        const float angle = (i * TWO_PI) / numSpikes + rotation;
+
+        // Draw the main spike
+        const PointF endPoint{center.x + std::cos(angle) * outerRadius, center.y + std::sin(angle) * outerRadius};
+        recorder.Line(center, endPoint, size * 0.15f);
+
+        // Draw small intersecting lines between main spikes
+        if (i % 2 == 0)
+        {
+            const float crossAngle = angle + (TWO_PI / numSpikes / 2);
+            const PointF crossPoint{center.x + std::cos(crossAngle) * innerRadius,
+                                    center.y + std::sin(crossAngle) * innerRadius};
+            recorder.Line(center, crossPoint, size * 0.1f);
+        }
+    }
+}
+
+} // namespace RainEngine
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "DisplayData.h"
+#include "FlowField.h"
+#include "Settings.h"
+#include "Vector2.h"
+
+// Forward declarations to keep Direct2D out of the simulation core
+struct ID2D1DeviceContext;
+
+namespace RainEngine {
+
+class DrawRecorder;
+
+// Structure-of-arrays storage for every falling snow flake on one display.
+//
+// Each flake attribute lives in its own contiguous column. The columns are
+// padded to a whole number of LANES flakes, so Update can run its motion
+// kernel on blocks of LANES flakes with no scalar tail: every flake first
+// reads its turbulence from a coarse FlowField, then every block is advanced
+// with branch-free arithmetic and polynomial sin/cos that the compiler turns
+// into vector code. Flakes that leave the scene or come close enough to
+// settled snow to land on it are only noted in event lists during the
+// kernel; a scalar pass afterwards settles and respawns them.
+class SnowField {
+public:
+    // Flakes advanced together by the update kernel
+    static constexpr size_t LANES = 8;
+
+    explicit SnowField(DisplayData* pDispData) noexcept;
+    ~SnowField() noexcept = default;
+
+    SnowField(const SnowField&) = delete;
+    SnowField& operator=(const SnowField&) = delete;
+
+    // Append count flakes scattered over and above the scene
+    void Spawn(int count);
+
+    // Push every flake sideways by the snow wind, as SnowWindIntensity sets it
+    void ApplyWind(float windFactor, float deltaSeconds) noexcept;
+
+    // Advance every flake by deltaSeconds, then settle the flakes that
+    // touched settled snow and respawn the ones that left the scene
+    void Update(float deltaSeconds);
+
+    // Keep the first count flakes; flakes are interchangeable
+    void Truncate(size_t count) noexcept;
+
+    // Drop every flake and free the columns
+    void Clear() noexcept;
+    void Reserve(size_t capacity);
+
+    [[nodiscard]] size_t Size() const noexcept { return Count; }
+    [[nodiscard]] bool IsEmpty() const noexcept { return Count == 0; }
+    [[nodiscard]] Vector2 GetPosition(size_t index) const noexcept { return {PosX[index], PosY[index]}; }
+    [[nodiscard]] Vector2 GetVelocity(size_t index) const noexcept { return {VelX[index], VelY[index]}; }
+
+    // Flakes of the last Update that left the scene, and that came close
+    // enough to the settled snow to be checked against it
+    [[nodiscard]] size_t GetRespawnEventCount() const noexcept { return RespawnEvents.size(); }
+    [[nodiscard]] size_t GetSettleEventCount() const noexcept { return SettleEvents.size(); }
+
+    // Record, then replay the commands through Direct2D
+    void Draw(ID2D1DeviceContext* dc) const;
+    // Every shape of every visible flake, after its wind trail
+    void Record(DrawRecorder& recorder) const;
+
+private:
+    // Snowflake shape types
+    enum SnowflakeShape : std::uint8_t {
+        SHAPE_SIMPLE,   // Simple circular shape
+        SHAPE_CRYSTAL,  // Star-like crystal shape
+        SHAPE_HEXAGON,  // Hexagon shape
+        SHAPE_STAR      // Star shape with more branches
+    };
+
+    static constexpr float PI = 3.14159265359f;
+    static constexpr float TWO_PI = 6.28318530718f;
+
+    static constexpr float MAX_SPEED = 250.0f; // Increased max speed for more dynamic movement
+    static constexpr float NOISE_INTENSITY = 30.0f; // Maintained noise intensity from previous changes
+    static constexpr float NOISE_SCALE = 0.005f; // Maintained noise scale from previous changes
+    static constexpr float NOISE_TIMESCALE = 0.1f; // Maintained time scale from previous changes
+    // The noise clock used to tick once per flake update, so it ran as many
+    // times faster than real time as a monitor has flakes at the shipped
+    // MaxParticles; it now keeps that pace whatever the flake count
+    static constexpr float NOISE_CLOCK_RATE = MAX_PARTICLES * 100.0f;
+    // Real time between cached flow field slices. At that pace a slice spans
+    // 0.125 noise units, still close enough to blend linearly.
+    static constexpr float FLOW_SLICE_SECONDS = 1.0f / 60.0f;
+    static constexpr float GRAVITY = 12.0f; // Maintained gravity from previous changes
+    static constexpr float MAX_WOBBLE = 1.2f; // Increased max wobble for more visible wind effects
+    static constexpr float WIND_RESISTANCE = 0.25f; // Increased wind resistance for more visible effects
+    static constexpr float MAX_WIND_SPEED = 80.0f; // Significantly increased max wind speed for more visible effects
+
+    DisplayData* pDisplayData; // Non-owning pointer
+
+    size_t Count = 0; // Live flakes; the columns hold Count rounded up to LANES
+
+    // Per-flake columns
+    std::vector<float> PosX;
+    std::vector<float> PosY;
+    std::vector<float> VelX;
+    std::vector<float> VelY;
+    std::vector<float> FlakeSize;       // Size of the snowflake
+    std::vector<float> Rotation;        // Current rotation angle
+    std::vector<float> RotationSpeed;   // Speed of rotation
+    std::vector<float> Opacity;         // Transparency value (0.0 - 1.0)
+    std::vector<float> WobblePhase;     // Phase for the wobble effect
+    std::vector<float> WobbleAmplitude; // Amplitude of the wobble
+    std::vector<float> WindResistance;  // Individual wind resistance for this snowflake
+    std::vector<std::uint8_t> Shape;
+
+    // Turbulence noise, cached on a coarse grid, and its clock
+    FlowField Flow;
+    double NoiseTime = 0.0;
+
+    // Per-step buffers, reused so steady-state snow does not allocate
+    std::vector<float> Turbulence;           // Noise sample per flake
+    std::vector<std::uint32_t> RespawnEvents; // Flakes that left the scene
+    std::vector<std::uint32_t> SettleEvents;  // Flakes at or below the snow line
+    std::vector<std::uint32_t> Respawns;      // Flakes to start over at the end of the step
+
+    // Randoms for a block of new flakes, drawn a column at a time
+    struct SpawnBlock;
+
+    [[nodiscard]] size_t PaddedSize() const noexcept { return PosX.size(); }
+    void Resize(size_t count);
+
+    void RespawnFlakes(const std::vector<std::uint32_t>& indices);
+    void DrawSpawnBlock(SpawnBlock& block, size_t count, bool aboveScene) const;
+    void StoreSpawn(const SpawnBlock& block, size_t slot, size_t index);
+
+    void SampleTurbulence(float deltaSeconds);
+
+    // Land a flake that touches settled snow; true if it is done falling
+    [[nodiscard]] bool SettleFlake(size_t index);
+
+    // The wind trail and shape of one flake, if it is in the scene
+    void RecordFlake(DrawRecorder& recorder, size_t index) const;
+    // Helper methods for recording the different snowflake shapes
+    static void RecordSimpleSnowflake(DrawRecorder& recorder, PointF center, float size, float rotation);
+    static void RecordCrystalSnowflake(DrawRecorder& recorder, PointF center, float size, float rotation);
+    static void RecordHexagonSnowflake(DrawRecorder& recorder, PointF center, float size, float rotation);
+    static void RecordStarSnowflake(DrawRecorder& recorder, PointF center, float size, float rotation);
+};
+
+} // namespace RainEngine
@@ -0,0 +1,408 @@
+#include "SnowGrid.h"
+
+#include <algorithm>
+#include <bit>
+#include <memory>
+
+#include "CounterRandom.h"
+#include "WorkerPool.h"
+
+namespace RainEngine {
+
+namespace {
+
+using SnowRules::ACTIVE_THRESHOLD;
+using SnowRules::LEFT_FIRST_THRESHOLD;
+using SnowRules::PhaseMask;
+
+constexpr std::uint8_t READY_ACTIVE = 1 << 0;
+constexpr std::uint8_t READY_CHOICES = 1 << 1;
+
+// Stream ids of the per-cell decisions
+constexpr std::uint64_t DECISION_ACTIVE = 0;
+constexpr std::uint64_t DECISION_LEFT_FIRST = 1;
+constexpr std::uint64_t DECISION_ACCUMULATE = 2;
+
+} // namespace
+
+SnowGrid::SnowGrid(const int width, const int height, const std::uint64_t seed)
+    : SettledSnow(width, height, seed),
+      lastWordMask_((width & 63) == 0 ? ~std::uint64_t{0} : (std::uint64_t{1} << (width & 63)) - 1),
+      zeroRow_(wordsPerRow_, 0),
+      chunkRows_((static_cast<size_t>(height) + CHUNK_ROWS - 1) / CHUNK_ROWS)
+{
+    bands_.resize(chunkRows_);
+
+    // Every chunk starts asleep; an empty chunk has nothing to settle
+    chunkAwake_.assign(chunkRows_ * wordsPerRow_, 0);
+    chunkTouched_.assign(chunkRows_ * wordsPerRow_, 0);
+    chunkQuiet_.assign(chunkRows_ * wordsPerRow_, 0);
+    bandAwake_.assign(chunkRows_, 0);
+}
+
+void SnowGrid::ResizeScratch(const size_t threads)
+{
+    const size_t first = scratch_.size();
+    scratch_.resize(std::max(first, threads));
+    for (size_t i = first; i < scratch_.size(); ++i)
+    {
+        RowScratch& s = scratch_[i];
+        for (auto* column : { &s.activeRandom, &s.leftFirst, &s.accumulate, &s.active, &s.down, &s.moveLeft,
+                              &s.moveRight, &s.growUpLeft, &s.growLeft, &s.growDownLeft, &s.growUp,
+                              &s.growUpRight, &s.growRight, &s.growDownRight })
+        {
+            column->assign(wordsPerRow_, 0);
+        }
+        s.randomReady.assign(wordsPerRow_, 0);
+    }
+}
+
+void SnowGrid::Clear() noexcept
+{
+    for (auto& band : bands_)
+    {
+        band.reset();
+    }
+    MarkAllRowsChanged();
+    std::fill(chunkAwake_.begin(), chunkAwake_.end(), 0);
+    std::fill(chunkTouched_.begin(), chunkTouched_.end(), 0);
+    std::fill(chunkQuiet_.begin(), chunkQuiet_.end(), 0);
+}
+
+void SnowGrid::ReadRow(const int y, std::uint64_t* out) const noexcept
+{
+    std::copy(Row(y), Row(y) + wordsPerRow_, out);
+}
+
+std::uint64_t* SnowGrid::MutableRow(const int y)
+{
+    auto& band = bands_[static_cast<size_t>(y / CHUNK_ROWS)];
+    if (!band)
+    {
+        band = std::make_unique<std::uint64_t[]>(CHUNK_ROWS * wordsPerRow_); // Zero-filled
+    }
+    return band.get() + static_cast<size_t>(y % CHUNK_ROWS) * wordsPerRow_;
+}
+
+size_t SnowGrid::CountSnow() const noexcept
+{
+    size_t count = 0;
+    for (const auto& band : bands_)
+    {
+        if (!band) continue;
+        for (size_t i = 0; i < CHUNK_ROWS * wordsPerRow_; ++i)
+        {
+            count += static_cast<size_t>(std::popcount(band[i]));
+        }
+    }
+    return count;
+}
+
+size_t SnowGrid::CountAllocatedBands() const noexcept
+{
+    return static_cast<size_t>(std::count_if(bands_.begin(), bands_.end(), [](const auto& band) noexcept {
+        return band != nullptr;
+    }));
+}
+
+size_t SnowGrid::GetMemoryUsage() const noexcept
+{
+    const size_t chunkBytes = chunkAwake_.capacity() + chunkTouched_.capacity() + chunkQuiet_.capacity() +
+                              bandAwake_.capacity();
+    return CountAllocatedBands() * CHUNK_ROWS * wordsPerRow_ * sizeof(std::uint64_t) +
+           bands_.capacity() * sizeof(bands_[0]) + zeroRow_.capacity() * sizeof(std::uint64_t) +
+           rowVersion_.capacity() * sizeof(std::uint32_t) + chunkBytes;
+}
+
+size_t SnowGrid::CountAwakeChunks() const noexcept
+{
+    return static_cast<size_t>(std::count(chunkAwake_.begin(), chunkAwake_.end(), std::uint8_t{1}));
+}
+
+std::uint64_t SnowGrid::DecisionMask(const int y, const size_t wordIndex, const std::uint64_t decision,
+                                     const std::uint32_t threshold) const noexcept
+{
+    // Word w holds cells x = 64w .. 64w + 63, so keying on the word keys every lane's cell
+    const std::uint64_t key = CounterRandom::Key(seed_, passIndex_, static_cast<std::uint64_t>(y),
+                                                 static_cast<std::uint64_t>(wordIndex), decision);
+    return CounterRandom::LaneMask(key, threshold);
+}
+
+void SnowGrid::Settle(int topRow, const float accumulationChance)
+{
+    const std::uint32_t accumulateThreshold = SnowRules::AccumulateThreshold(accumulationChance);
+
+    // Pick up flakes that landed since the last pass
+    PropagateWakes();
+    for (size_t band = 0; band < chunkRows_; ++band)
+    {
+        const auto first = chunkAwake_.begin() + static_cast<std::ptrdiff_t>(band * wordsPerRow_);
+        bandAwake_[band] = std::find(first, first + static_cast<std::ptrdiff_t>(wordsPerRow_), std::uint8_t{1}) !=
+                           first + static_cast<std::ptrdiff_t>(wordsPerRow_);
+    }
+
+    WorkerPool& pool = WorkerPool::Shared();
+    ResizeScratch(pool.GetThreadCount());
+
+    // Settle band k covers rows [k * bandRows - offset, (k + 1) * bandRows - offset)
+    topRow = std::max(topRow, 0);
+    constexpr int bandRows = SETTLE_BAND_CHUNKS * CHUNK_ROWS;
+    const int offset = (passIndex_ & 1) != 0 ? CHUNK_ROWS : 0;
+    const int bandCount = (height_ + offset + bandRows - 1) / bandRows;
+    const auto bandFirstRow = [&](const int band) noexcept { return std::max(band * bandRows - offset, topRow); };
+    const auto bandLastRow = [&](const int band) noexcept { return std::min((band + 1) * bandRows - offset, height_) - 1; };
+
+    for (int parity = 0; parity < 2; ++parity)
+    {
+        settleBands_.clear();
+        for (int band = parity; band < bandCount; band += 2)
+        {
+            const int firstRow = bandFirstRow(band);
+            const int lastRow = bandLastRow(band);
+            if (firstRow > lastRow) continue;
+            for (int chunkRow = firstRow / CHUNK_ROWS; chunkRow <= lastRow / CHUNK_ROWS; ++chunkRow)
+            {
+                if (bandAwake_[static_cast<size_t>(chunkRow)])
+                {
+                    settleBands_.push_back(band);
+                    break;
+                }
+            }
+        }
+
+        // Iterate each band bottom-up, to avoid updating falling pixels multiple times per pass
+        pool.ParallelFor(settleBands_.size(), [&](const size_t item, const size_t thread) {
+            const int band = settleBands_[item];
+            for (int y = bandLastRow(band); y >= bandFirstRow(band); --y)
+            {
+                if (bandAwake_[static_cast<size_t>(y / CHUNK_ROWS)])
+                {
+                    SettleRow(y, accumulateThreshold, scratch_[thread]);
+                }
+            }
+        });
+    }
+
+    UpdateSleep();
+    ++passIndex_;
+}
+
+void SnowGrid::PropagateWakes() noexcept
+{
+    const size_t columns = wordsPerRow_;
+    for (size_t band = 0; band < chunkRows_; ++band)
+    {
+        for (size_t column = 0; column < columns; ++column)
+        {
+            const size_t index = band * columns + column;
+            if (!chunkTouched_[index]) continue;
+            chunkTouched_[index] = 0;
+
+            const size_t firstBand = band > 0 ? band - 1 : band;
+            const size_t lastBand = std::min(band + 1, chunkRows_ - 1);
+            const size_t firstColumn = column > 0 ? column - 1 : column;
+            const size_t lastColumn = std::min(column + 1, columns - 1);
+            for (size_t b = firstBand; b <= lastBand; ++b)
+            {
+                for (size_t c = firstColumn; c <= lastColumn; ++c)
+                {
+                    chunkAwake_[b * columns + c] = 1;
+                    chunkQuiet_[b * columns + c] = 0;
+                }
+            }
+        }
+    }
+}
+
+void SnowGrid::UpdateSleep() noexcept
+{
+    for (size_t index = 0; index < chunkAwake_.size(); ++index)
+    {
+        if (chunkAwake_[index] && chunkQuiet_[index] < QUIET_PASSES)
+        {
+            ++chunkQuiet_[index];
+        }
+    }
+
+    // Chunks that changed this pass, and their neighbours, stay awake
+    PropagateWakes();
+
+    // Quiet chunks sleep once nothing in them can fall or slide. Stuck cells
+    // that could still grow by accumulation do not keep a chunk awake.
+    for (size_t index = 0; index < chunkAwake_.size(); ++index)
+    {
+        if (chunkAwake_[index] && chunkQuiet_[index] >= QUIET_PASSES &&
+            !HasMovableCells(index % wordsPerRow_, index / wordsPerRow_))
+        {
+            chunkAwake_[index] = 0;
+        }
+    }
+}
+
+bool SnowGrid::HasMovableCells(const size_t wordIndex, const size_t band) const noexcept
+{
+    const int firstRow = static_cast<int>(band) * CHUNK_ROWS;
+    const int lastRow = std::min(firstRow + CHUNK_ROWS, height_);
+    for (int y = firstRow; y < lastRow; ++y)
+    {
+        const std::uint64_t* row = Row(y);
+        const std::uint64_t snow = row[wordIndex];
+        if (snow == 0) continue;
+
+        const std::uint64_t* below = y + 1 < height_ ? Row(y + 1) : nullptr;
+        const std::uint64_t canMove = FreeCells(below, wordIndex) |
+            (FreeCellsLeft(below, wordIndex) & FreeCellsLeft(row, wordIndex)) |
+            (FreeCellsRight(below, wordIndex) & FreeCellsRight(row, wordIndex));
+        if (snow & canMove) return true;
+    }
+    return false;
+}
+
+void SnowGrid::SettleRow(const int y, const std::uint32_t accumulateThreshold, RowScratch& s)
+{
+    const size_t n = wordsPerRow_;
+    if (!bands_[static_cast<size_t>(y / CHUNK_ROWS)])
+        return;
+    std::uint64_t* row = MutableRow(y);
+    if (std::all_of(row, row + n, [](const std::uint64_t word) noexcept { return word == 0; }))
+        return;
+
+    // The rows above and below are only read until a cell moves into them,
+    // so a band that snow never reaches is never allocated
+    const std::uint64_t* below = y + 1 < height_ ? Row(y + 1) : nullptr;
+    const std::uint64_t* above = y > 0 ? Row(y - 1) : nullptr;
+
+    std::fill(s.randomReady.begin(), s.randomReady.end(), 0);
+    const std::uint8_t* awake = chunkAwake_.data() + ChunkIndex(0, y);
+
+    for (int phase = 0; phase < 3; ++phase)
+    {
+        // Pick the lanes of this phase that move on this pass; sleeping chunks stay put
+        bool anyActive = false;
+        for (size_t i = 0; i < n; ++i)
+        {
+            std::uint64_t active = awake[i] ? row[i] & PhaseMask(i, phase) : 0;
+            if (active != 0)
+            {
+                if (!(s.randomReady[i] & READY_ACTIVE))
+                {
+                    s.activeRandom[i] = DecisionMask(y, i, DECISION_ACTIVE, ACTIVE_THRESHOLD);
+                    s.randomReady[i] |= READY_ACTIVE;
+                }
+                active &= s.activeRandom[i];
+            }
+            if (active != 0 && !(s.randomReady[i] & READY_CHOICES))
+            {
+                s.leftFirst[i] = DecisionMask(y, i, DECISION_LEFT_FIRST, LEFT_FIRST_THRESHOLD);
+                s.accumulate[i] = DecisionMask(y, i, DECISION_ACCUMULATE, accumulateThreshold);
+                s.randomReady[i] |= READY_CHOICES;
+            }
+            s.active[i] = active;
+            anyActive |= active != 0;
+        }
+        if (!anyActive) continue;
+
+        // Decide every move of the phase from the state before the phase.
+        // Cells of one phase are three apart, so none of them reads or
+        // writes a cell another one touches.
+        for (size_t i = 0; i < n; ++i)
+        {
+            const std::uint64_t active = s.active[i];
+
+            // Free neighbours aligned to the cell: ...L is x - 1, ...R is x + 1
+            const std::uint64_t rowFreeL = FreeCellsLeft(row, i);
+            const std::uint64_t rowFreeR = FreeCellsRight(row, i);
+            const std::uint64_t belowFree = FreeCells(below, i);
+            const std::uint64_t belowFreeL = FreeCellsLeft(below, i);
+            const std::uint64_t belowFreeR = FreeCellsRight(below, i);
+            const std::uint64_t aboveFree = FreeCells(above, i);
+            const std::uint64_t aboveFreeL = FreeCellsLeft(above, i);
+            const std::uint64_t aboveFreeR = FreeCellsRight(above, i);
+
+            // Flow downwards
+            const std::uint64_t down = active & belowFree;
+
+            // Try to flow down and left/right, random side first
+            const std::uint64_t blocked = active & ~down;
+            const std::uint64_t canLeft = belowFreeL & rowFreeL;
+            const std::uint64_t canRight = belowFreeR & rowFreeR;
+            const std::uint64_t leftFirst = s.leftFirst[i];
+            const std::uint64_t moveLeft = blocked & canLeft & (leftFirst | ~canRight);
+            const std::uint64_t moveRight = blocked & canRight & (~leftFirst | ~canLeft);
+
+            // Stuck cells may grow into their first free neighbour, scanning
+            // columns x-1, x, x+1 and rows y-1, y, y+1 in that order. The cell
+            // below is never free here, so that candidate is left out.
+            std::uint64_t grow = blocked & ~(moveLeft | moveRight) & s.accumulate[i];
+            s.growUpLeft[i] = grow & aboveFreeL;       grow &= ~s.growUpLeft[i];
+            s.growLeft[i] = grow & rowFreeL;           grow &= ~s.growLeft[i];
+            s.growDownLeft[i] = grow & belowFreeL;     grow &= ~s.growDownLeft[i];
+            s.growUp[i] = grow & aboveFree;            grow &= ~s.growUp[i];
+            s.growUpRight[i] = grow & aboveFreeR;      grow &= ~s.growUpRight[i];
+            s.growRight[i] = grow & rowFreeR;          grow &= ~s.growRight[i];
+            s.growDownRight[i] = grow & belowFreeR;
+
+            s.down[i] = down;
+            s.moveLeft[i] = moveLeft;
+            s.moveRight[i] = moveRight;
+        }
+
+        // Apply the phase. Moves towards x - 1 carry bit 0 into bit 63 of the
+        // previous word, moves towards x + 1 carry bit 63 into the next word.
+        const auto toLeft = [n](const std::vector<std::uint64_t>& m, const size_t i) noexcept {
+            return (m[i] >> 1) | (i + 1 < n ? m[i + 1] << 63 : 0);
+        };
+        const auto toRight = [](const std::vector<std::uint64_t>& m, const size_t i) noexcept {
+            return (m[i] << 1) | (i > 0 ? m[i - 1] >> 63 : 0);
+        };
+
+        // Every word that changes marks its chunk as touched and its row as changed
+        const size_t rowChunk = ChunkIndex(0, y);
+        const size_t belowChunk = below ? ChunkIndex(0, y + 1) : 0;
+        const size_t aboveChunk = above ? ChunkIndex(0, y - 1) : 0;
+        bool rowChanged = false;
+        bool belowChanged = false;
+        bool aboveChanged = false;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const std::uint64_t newRow = (row[i] & ~(s.down[i] | s.moveLeft[i] | s.moveRight[i])) |
+                                         toLeft(s.growLeft, i) | toRight(s.growRight, i);
+            if (newRow != row[i])
+            {
+                row[i] = newRow;
+                chunkTouched_[rowChunk + i] = 1;
+                rowChanged = true;
+            }
+            if (below)
+            {
+                const std::uint64_t added = s.down[i] | toLeft(s.moveLeft, i) | toRight(s.moveRight, i) |
+                                            toLeft(s.growDownLeft, i) | toRight(s.growDownRight, i);
+                if (added & ~below[i])
+                {
+                    std::uint64_t* target = MutableRow(y + 1);
+                    below = target;
+                    target[i] |= added;
+                    chunkTouched_[belowChunk + i] = 1;
+                    belowChanged = true;
+                }
+            }
+            if (above)
+            {
+                const std::uint64_t added = toLeft(s.growUpLeft, i) | s.growUp[i] | toRight(s.growUpRight, i);
+                if (added & ~above[i])
+                {
+                    std::uint64_t* target = MutableRow(y - 1);
+                    above = target;
+                    target[i] |= added;
+                    chunkTouched_[aboveChunk + i] = 1;
+                    aboveChanged = true;
+                }
+            }
+        }
+        if (rowChanged) MarkRowChanged(y);
+        if (belowChanged) MarkRowChanged(y + 1);
+        if (aboveChanged) MarkRowChanged(y - 1);
+    }
+}
+
+} // namespace RainEngine
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "SettledSnow.h"
+
+namespace RainEngine {
+
+// Settled snow for one display, one bit per scene pixel.
+//
+// Row y occupies GetWordsPerRow() consecutive 64-bit words; pixel x lives in
+// bit (x % 64) of word (x / 64). Bits past the scene width in the last word
+// of a row are always zero. Out-of-bounds cells count as solid ground for the
+// settling rules, exactly like the old bool-per-pixel grid.
+//
+// The grid is also divided into chunks of one word by CHUNK_ROWS rows. A
+// chunk is awake while anything in or next to it changes; after QUIET_PASSES
+// settling passes without change, and with no cell left that could fall or
+// slide, it goes to sleep and Settle skips it until a flake lands in it or a
+// neighbouring chunk changes.
+//
+// Settling passes run on the shared WorkerPool. The rows are cut into
+// settle bands of SETTLE_BAND_CHUNKS chunk rows; all even bands settle in
+// parallel, then all odd ones. A cell only ever reads and writes the rows
+// next to its own, so two bands of the same parity never touch the same row
+// or the same storage band. Every band is swept bottom-up like the grid
+// used to be as a whole; only moves across a band edge see the rows on the
+// other side one phase early or late, and the band edges shift by a chunk
+// row every other pass so no row is always an edge. The schedule does not
+// depend on the thread count, so a pass stays a pure function of the grid,
+// the seed and the pass number.
+//
+// Cell storage is allocated lazily, one band of CHUNK_ROWS rows at a time,
+// the first time snow is written into the band. Rows of bands never reached
+// read as air from a shared zero row, and Clear frees every band, so a
+// display only commits memory for the rows its snow actually occupies.
+class SnowGrid final : public SettledSnow {
+public:
+    static constexpr int CHUNK_ROWS = 16;
+    static constexpr std::uint8_t QUIET_PASSES = 32;
+    static constexpr int SETTLE_BAND_CHUNKS = 2; // At least 2, so same-parity bands never share a storage band
+
+    // seed keys every random decision of the settling rules
+    SnowGrid(int width, int height, std::uint64_t seed);
+
+    [[nodiscard]] bool IsSnow(int x, int y) const noexcept override {
+        if (x < 0 || x >= width_ || y < 0 || y >= height_) return false;
+        return (Row(y)[x >> 6] >> (x & 63)) & 1u;
+    }
+
+    [[nodiscard]] bool IsAir(int x, int y) const noexcept override {
+        if (x < 0 || x >= width_ || y < 0 || y >= height_) return false;
+        return !((Row(y)[x >> 6] >> (x & 63)) & 1u);
+    }
+
+    // Sets the cell and wakes the chunk around it; may allocate the cell's band
+    void SetSnow(int x, int y) override {
+        MutableRow(y)[x >> 6] |= std::uint64_t{1} << (x & 63);
+        chunkTouched_[ChunkIndex(static_cast<size_t>(x >> 6), y)] = 1;
+        MarkRowChanged(y);
+    }
+
+    void ReadRow(int y, std::uint64_t* out) const noexcept override;
+
+    // Cells of row y; the shared zero row while its band is unallocated
+    [[nodiscard]] const std::uint64_t* Row(int y) const noexcept {
+        const auto& band = bands_[static_cast<size_t>(y / CHUNK_ROWS)];
+        return band ? band.get() + static_cast<size_t>(y % CHUNK_ROWS) * wordsPerRow_ : zeroRow_.data();
+    }
+
+    // Frees every band
+    void Clear() noexcept override;
+    [[nodiscard]] size_t CountSnow() const noexcept override;
+    [[nodiscard]] size_t CountAwakeChunks() const noexcept override;
+    [[nodiscard]] size_t GetMemoryUsage() const noexcept override;
+    [[nodiscard]] size_t CountAllocatedBands() const noexcept;
+
+    // One settling pass over rows [topRow, height): every snow cell gets a
+    // 2-in-11 chance to fall straight down, else slide diagonally (random side
+    // first), else with accumulationChance grow into the first free neighbour.
+    // Each cell's draws are keyed on (seed, pass, y, x), so a pass is fully
+    // determined by the grid contents, the seed and the pass number.
+    // Settle bands are processed bottom-up a word at a time, even bands then
+    // odd bands; within a row the cells are handled in three interleaved
+    // phases (x % 3) whose neighbourhoods do not overlap, so every phase is a
+    // handful of whole-word mask operations.
+    void Settle(int topRow, float accumulationChance) override;
+
+private:
+    std::uint64_t lastWordMask_; // Valid bits in the last word of each row
+
+    // Cell storage, one CHUNK_ROWS x wordsPerRow_ block per band, null until written
+    std::vector<std::unique_ptr<std::uint64_t[]>> bands_;
+    std::vector<std::uint64_t> zeroRow_;
+
+    // Chunk state, indexed by ChunkIndex
+    size_t chunkRows_;
+    std::vector<std::uint8_t> chunkAwake_;
+    std::vector<std::uint8_t> chunkTouched_;   // Changed since the last wake propagation
+    std::vector<std::uint8_t> chunkQuiet_;     // Passes since the chunk or a neighbour last changed
+    std::vector<std::uint8_t> bandAwake_;      // Any chunk of the band awake, refreshed per pass
+
+    // Per-row scratch, sized to one row and reused across passes; one per pool thread
+    struct RowScratch {
+        std::vector<std::uint64_t> activeRandom; // Lanes that get to move this pass
+        std::vector<std::uint64_t> leftFirst;    // Lanes that try the left diagonal first
+        std::vector<std::uint64_t> accumulate;   // Lanes that grow when stuck
+        std::vector<std::uint8_t> randomReady;   // Which of the masks above are drawn for a word
+        std::vector<std::uint64_t> active;
+        std::vector<std::uint64_t> down;
+        std::vector<std::uint64_t> moveLeft;
+        std::vector<std::uint64_t> moveRight;
+        std::vector<std::uint64_t> growUpLeft;
+        std::vector<std::uint64_t> growLeft;
+        std::vector<std::uint64_t> growDownLeft;
+        std::vector<std::uint64_t> growUp;
+        std::vector<std::uint64_t> growUpRight;
+        std::vector<std::uint64_t> growRight;
+        std::vector<std::uint64_t> growDownRight;
+    };
+    std::vector<RowScratch> scratch_;
+    std::vector<int> settleBands_; // Bands of the current phase with anything awake
+
+    // Lanes of word wordIndex in row y set with probability threshold / 65536,
+    // drawn for one of the rule decisions of the current pass
+    [[nodiscard]] std::uint64_t DecisionMask(int y, size_t wordIndex, std::uint64_t decision,
+                                             std::uint32_t threshold) const noexcept;
+
+    [[nodiscard]] std::uint64_t WordMask(size_t wordIndex) const noexcept {
+        return wordIndex + 1 == wordsPerRow_ ? lastWordMask_ : ~std::uint64_t{0};
+    }
+
+    // Free cells of word i of a row, aligned to x, x - 1 and x + 1.
+    // A null row or a word outside the row is solid.
+    [[nodiscard]] std::uint64_t FreeCells(const std::uint64_t* cells, size_t i) const noexcept {
+        return cells && i < wordsPerRow_ ? ~cells[i] & WordMask(i) : 0;
+    }
+    [[nodiscard]] std::uint64_t FreeCellsLeft(const std::uint64_t* cells, size_t i) const noexcept {
+        return (FreeCells(cells, i) << 1) | (i > 0 ? FreeCells(cells, i - 1) >> 63 : 0);
+    }
+    [[nodiscard]] std::uint64_t FreeCellsRight(const std::uint64_t* cells, size_t i) const noexcept {
+        return (FreeCells(cells, i) >> 1) | (FreeCells(cells, i + 1) << 63);
+    }
+
+    [[nodiscard]] size_t ChunkIndex(size_t wordIndex, int y) const noexcept {
+        return static_cast<size_t>(y / CHUNK_ROWS) * wordsPerRow_ + wordIndex;
+    }
+
+    // Cells of row y for writing, allocating its band (all air) on first use
+    [[nodiscard]] std::uint64_t* MutableRow(int y);
+
+    void SettleRow(int y, std::uint32_t accumulateThreshold, RowScratch& s);
+    void ResizeScratch(size_t threads);
+
+    // Wake every touched chunk and its eight neighbours
+    void PropagateWakes() noexcept;
+    void UpdateSleep() noexcept;
+    [[nodiscard]] bool HasMovableCells(size_t wordIndex, size_t band) const noexcept;
+};
+
+} // namespace RainEngine
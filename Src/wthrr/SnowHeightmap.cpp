@@ -0,0 +1,140 @@
+#include "SnowHeightmap.h"
+
+#include <algorithm>
+#include <bit>
+#include <numeric>
+
+#include "CounterRandom.h"
+
+namespace RainEngine {
+
+namespace {
+
+// Stream ids of the per-column decisions
+constexpr std::uint64_t DECISION_ACTIVE = 0;
+constexpr std::uint64_t DECISION_LEFT_FIRST = 1;
+constexpr std::uint64_t DECISION_ACCUMULATE = 2;
+
+} // namespace
+
+SnowHeightmap::SnowHeightmap(const int width, const int height, const std::uint64_t seed)
+    : SettledSnow(width, height, seed),
+      depth_(static_cast<size_t>(width), 0),
+      active_(wordsPerRow_, 0),
+      leftFirst_(wordsPerRow_, 0),
+      accumulate_(wordsPerRow_, 0)
+{
+}
+
+void SnowHeightmap::SetDepth(const int x, const int newDepth) noexcept
+{
+    const int oldDepth = depth_[static_cast<size_t>(x)];
+    depth_[static_cast<size_t>(x)] = static_cast<std::uint16_t>(newDepth);
+
+    // Rows between the old and the new top gained or lost this column's cell
+    const int first = height_ - std::max(oldDepth, newDepth);
+    const int last = height_ - std::min(oldDepth, newDepth);
+    for (int y = first; y < last; ++y)
+    {
+        MarkRowChanged(y);
+    }
+}
+
+void SnowHeightmap::SetSnow(const int x, int) noexcept
+{
+    const int depth = depth_[static_cast<size_t>(x)];
+    if (depth < height_)
+    {
+        SetDepth(x, depth + 1);
+    }
+}
+
+void SnowHeightmap::ReadRow(const int y, std::uint64_t* out) const noexcept
+{
+    // Column x reaches row y when its depth is at least height - y
+    const int minDepth = height_ - y;
+    std::fill(out, out + wordsPerRow_, 0);
+    for (int x = 0; x < width_; ++x)
+    {
+        if (depth_[static_cast<size_t>(x)] >= minDepth)
+        {
+            out[x >> 6] |= std::uint64_t{1} << (x & 63);
+        }
+    }
+}
+
+void SnowHeightmap::Clear() noexcept
+{
+    std::fill(depth_.begin(), depth_.end(), 0);
+    MarkAllRowsChanged();
+}
+
+size_t SnowHeightmap::CountSnow() const noexcept
+{
+    return std::accumulate(depth_.begin(), depth_.end(), size_t{0});
+}
+
+size_t SnowHeightmap::GetMemoryUsage() const noexcept
+{
+    return depth_.capacity() * sizeof(std::uint16_t) + rowVersion_.capacity() * sizeof(std::uint32_t) +
+           (active_.capacity() + leftFirst_.capacity() + accumulate_.capacity()) * sizeof(std::uint64_t);
+}
+
+void SnowHeightmap::Settle(int topRow, const float accumulationChance) noexcept
+{
+    const std::uint32_t accumulateThreshold = SnowRules::AccumulateThreshold(accumulationChance);
+    topRow = std::max(topRow, 0);
+    const int maxDepth = height_ - topRow + 1; // Growth may reach one row above topRow, as in the grid
+
+    for (size_t i = 0; i < wordsPerRow_; ++i)
+    {
+        const auto key = [&](const std::uint64_t decision) noexcept {
+            return CounterRandom::Key(seed_, passIndex_, 0, static_cast<std::uint64_t>(i), decision);
+        };
+        active_[i] = CounterRandom::LaneMask(key(DECISION_ACTIVE), SnowRules::ACTIVE_THRESHOLD);
+        leftFirst_[i] = active_[i] ? CounterRandom::LaneMask(key(DECISION_LEFT_FIRST), SnowRules::LEFT_FIRST_THRESHOLD) : 0;
+        accumulate_[i] = active_[i] ? CounterRandom::LaneMask(key(DECISION_ACCUMULATE), accumulateThreshold) : 0;
+    }
+
+    // Neighbours outside the scene are solid ground as high as the scene
+    const auto depthAt = [this](const int x) noexcept {
+        return x < 0 || x >= width_ ? height_ : static_cast<int>(depth_[static_cast<size_t>(x)]);
+    };
+
+    for (int phase = 0; phase < 3; ++phase)
+    {
+        for (size_t i = 0; i < wordsPerRow_; ++i)
+        {
+            std::uint64_t lanes = active_[i] & SnowRules::PhaseMask(i, phase);
+            while (lanes != 0)
+            {
+                const int bit = std::countr_zero(lanes);
+                lanes &= lanes - 1;
+                const int x = static_cast<int>(i) * 64 + bit;
+                if (x >= width_) break;
+
+                const int depth = depthAt(x);
+                if (depth == 0) continue;
+
+                // Shed the top cell onto a side that is too low, random side first
+                const bool canLeft = depth - depthAt(x - 1) > REPOSE_STEP;
+                const bool canRight = depth - depthAt(x + 1) > REPOSE_STEP;
+                if (canLeft || canRight)
+                {
+                    const bool leftFirst = (leftFirst_[i] >> bit) & 1u;
+                    const int target = canLeft && (leftFirst || !canRight) ? x - 1 : x + 1;
+                    SetDepth(x, depth - 1);
+                    SetDepth(target, depthAt(target) + 1);
+                }
+                else if (((accumulate_[i] >> bit) & 1u) && depth < maxDepth && depth < height_)
+                {
+                    SetDepth(x, depth + 1);
+                }
+            }
+        }
+    }
+
+    ++passIndex_;
+}
+
+} // namespace RainEngine
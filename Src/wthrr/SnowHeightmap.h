@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "SettledSnow.h"
+
+namespace RainEngine {
+
+// Settled snow as one depth per scene column, for snow that only piles up
+// from the bottom of the screen.
+//
+// Column x holds Depth(x) cells of snow resting on the floor, so there are
+// no overhangs and no air pockets. Instead of per-cell fall and slide rules,
+// each settling pass relaxes the surface towards its angle of repose: a
+// column standing more than REPOSE_STEP cells above a neighbour sheds its
+// top cell onto the lower side. A pass costs O(width) and the model needs a
+// couple of bytes per column plus one change counter per row.
+class SnowHeightmap final : public SettledSnow {
+public:
+    // Largest height difference between neighbouring columns that stays put (45 degrees)
+    static constexpr int REPOSE_STEP = 1;
+
+    // seed keys every random decision of the relaxation pass
+    SnowHeightmap(int width, int height, std::uint64_t seed);
+
+    [[nodiscard]] int Depth(int x) const noexcept { return depth_[static_cast<size_t>(x)]; }
+
+    [[nodiscard]] bool IsSnow(int x, int y) const noexcept override {
+        if (x < 0 || x >= width_ || y < 0 || y >= height_) return false;
+        return y >= height_ - depth_[static_cast<size_t>(x)];
+    }
+
+    [[nodiscard]] bool IsAir(int x, int y) const noexcept override {
+        if (x < 0 || x >= width_ || y < 0 || y >= height_) return false;
+        return y < height_ - depth_[static_cast<size_t>(x)];
+    }
+
+    // The flake lands on top of column x, whatever its height; snow never hangs in the air
+    void SetSnow(int x, int y) noexcept override;
+
+    void ReadRow(int y, std::uint64_t* out) const noexcept override;
+
+    // Every column gets a 2-in-11 chance to shed its top cell onto a
+    // neighbour more than REPOSE_STEP lower (random side first when both
+    // are), else with accumulationChance to grow by one cell, as long as its
+    // top stays at or below topRow. Draws are keyed on (seed, pass, x), and
+    // columns are handled in three interleaved phases (x % 3) so no two
+    // columns of a phase touch the same neighbour.
+    void Settle(int topRow, float accumulationChance) noexcept override;
+
+    void Clear() noexcept override;
+    [[nodiscard]] size_t CountSnow() const noexcept override;
+    [[nodiscard]] size_t GetMemoryUsage() const noexcept override;
+
+private:
+    std::vector<std::uint16_t> depth_;
+
+    // Per-pass lane masks, one word per 64 columns
+    std::vector<std::uint64_t> active_;
+    std::vector<std::uint64_t> leftFirst_;
+    std::vector<std::uint64_t> accumulate_;
+
+    // Change column x from its current depth to newDepth and mark the rows in between
+    void SetDepth(int x, int newDepth) noexcept;
+};
+
+} // namespace RainEngine
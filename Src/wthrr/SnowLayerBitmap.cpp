@@ -0,0 +1,217 @@
+#include "SnowLayerBitmap.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "DrawRecorder.h"
+
+#ifdef _WIN32
+#include <d2d1.h>
+#endif
+
+namespace RainEngine {
+
+namespace {
+
+// Premultiplied B8G8R8A8, as a little-endian 32-bit value
+[[nodiscard]] std::uint32_t PackPremultiplied(const Color& color) noexcept {
+    const float alpha = std::clamp(color.a, 0.0f, 1.0f);
+    const auto channel = [alpha](const float value) noexcept {
+        return static_cast<std::uint32_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * alpha * 255.0f));
+    };
+    return (static_cast<std::uint32_t>(std::lround(alpha * 255.0f)) << 24) |
+           (channel(color.r) << 16) | (channel(color.g) << 8) | channel(color.b);
+}
+
+} // namespace
+
+void SnowLayerBitmap::Resize(const SettledSnow& snow)
+{
+    width_ = snow.GetWidth();
+    height_ = snow.GetHeight();
+    wordsPerRow_ = snow.GetWordsPerRow();
+    pixels_.assign(static_cast<size_t>(width_) * static_cast<size_t>(height_), 0);
+    shadow_.assign(wordsPerRow_ * static_cast<size_t>(height_), 0);
+    rowVersion_.assign(static_cast<size_t>(height_), 0);
+    rowWords_.assign(wordsPerRow_, 0);
+    valid_ = false;
+}
+
+void SnowLayerBitmap::Release() noexcept
+{
+    pixels_ = {};
+    shadow_ = {};
+    rowVersion_ = {};
+    rowWords_ = {};
+    dirtyRects_ = {};
+    width_ = 0;
+    height_ = 0;
+    wordsPerRow_ = 0;
+    valid_ = false;
+    #ifdef _WIN32
+    bitmap_.Reset();
+    bitmapOwner_ = nullptr;
+    #endif
+}
+
+const std::vector<Rect>& SnowLayerBitmap::Update(const SettledSnow& snow, const Color& color)
+{
+    dirtyRects_.clear();
+
+    if (pixels_.empty() || width_ != snow.GetWidth() || height_ != snow.GetHeight())
+    {
+        Resize(snow);
+    }
+    const std::uint32_t pixel = PackPremultiplied(color);
+    if (pixel != pixel_)
+    {
+        pixel_ = pixel;
+        valid_ = false;
+    }
+
+    if (!valid_)
+    {
+        // Rewrite everything and upload the whole layer
+        for (int y = 0; y < height_; ++y)
+        {
+            std::uint64_t* shadow = shadow_.data() + static_cast<size_t>(y) * wordsPerRow_;
+            snow.ReadRow(y, shadow);
+            for (size_t i = 0; i < wordsPerRow_; ++i)
+            {
+                RasterizeWord(y, i, shadow[i]);
+            }
+            rowVersion_[static_cast<size_t>(y)] = snow.GetRowVersion(y);
+        }
+        dirtyRects_.push_back({0, 0, width_, height_});
+        valid_ = true;
+        return dirtyRects_;
+    }
+
+    for (int y = 0; y < height_; ++y)
+    {
+        const std::uint32_t version = snow.GetRowVersion(y);
+        if (version == rowVersion_[static_cast<size_t>(y)]) continue;
+        rowVersion_[static_cast<size_t>(y)] = version;
+
+        // Only the words that actually differ are rewritten and uploaded
+        const std::uint64_t* row = rowWords_.data();
+        snow.ReadRow(y, rowWords_.data());
+        std::uint64_t* shadow = shadow_.data() + static_cast<size_t>(y) * wordsPerRow_;
+        size_t first = wordsPerRow_;
+        size_t last = 0;
+        for (size_t i = 0; i < wordsPerRow_; ++i)
+        {
+            if (row[i] == shadow[i]) continue;
+            shadow[i] = row[i];
+            RasterizeWord(y, i, row[i]);
+            first = std::min(first, i);
+            last = i;
+        }
+        if (first < wordsPerRow_)
+        {
+            AddDirtyRow(y, static_cast<int>(first) * 64, std::min(width_, static_cast<int>(last + 1) * 64));
+        }
+    }
+
+    if (dirtyRects_.size() > MAX_DIRTY_RECTS)
+    {
+        Rect bounds = dirtyRects_.front();
+        for (const Rect& rect : dirtyRects_)
+        {
+            bounds.left = std::min(bounds.left, rect.left);
+            bounds.top = std::min(bounds.top, rect.top);
+            bounds.right = std::max(bounds.right, rect.right);
+            bounds.bottom = std::max(bounds.bottom, rect.bottom);
+        }
+        dirtyRects_.assign(1, bounds);
+    }
+    return dirtyRects_;
+}
+
+void SnowLayerBitmap::RasterizeWord(const int y, const size_t wordIndex, const std::uint64_t cells) noexcept
+{
+    const int x0 = static_cast<int>(wordIndex) * 64;
+    const int count = std::min(64, width_ - x0);
+    std::uint32_t* out = pixels_.data() + static_cast<size_t>(y) * static_cast<size_t>(width_) + static_cast<size_t>(x0);
+    for (int bit = 0; bit < count; ++bit)
+    {
+        // All ones for snow, zero for air
+        const std::uint32_t mask = 0u - static_cast<std::uint32_t>((cells >> bit) & 1u);
+        out[bit] = pixel_ & mask;
+    }
+}
+
+void SnowLayerBitmap::AddDirtyRow(const int y, const int left, const int right)
+{
+    // Rows changed one after another grow the previous rectangle downwards
+    if (!dirtyRects_.empty() && dirtyRects_.back().bottom == y)
+    {
+        Rect& rect = dirtyRects_.back();
+        rect.left = std::min(rect.left, left);
+        rect.right = std::max(rect.right, right);
+        rect.bottom = y + 1;
+        return;
+    }
+    dirtyRects_.push_back({left, y, right, y + 1});
+}
+
+void SnowLayerBitmap::Record(DrawRecorder& recorder, const SettledSnow& snow, const Color& color,
+                             const Rect& sceneRect, const int cellSize)
+{
+    Update(snow, color);
+    recorder.Bitmap(DestRect(sceneRect, cellSize));
+}
+
+#ifdef _WIN32
+void SnowLayerBitmap::Draw(ID2D1DeviceContext* dc, const SettledSnow& snow, const Color& color, const Rect& sceneRect,
+                           const int cellSize)
+{
+    // A bitmap from another context or of another size is of no use
+    const bool recreate = !bitmap_ || bitmapOwner_ != dc ||
+                          width_ != snow.GetWidth() || height_ != snow.GetHeight();
+    if (recreate)
+    {
+        bitmap_.Reset();
+        Invalidate();
+    }
+
+    Update(snow, color);
+    const UINT32 pitch = static_cast<UINT32>(GetPitch());
+
+    if (recreate)
+    {
+        const D2D1_BITMAP_PROPERTIES properties = D2D1::BitmapProperties(
+            D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED));
+        if (FAILED(dc->CreateBitmap(D2D1::SizeU(static_cast<UINT32>(width_), static_cast<UINT32>(height_)),
+                                    pixels_.data(), pitch, properties, &bitmap_)))
+        {
+            bitmap_.Reset();
+            return; // Try again next frame
+        }
+        bitmapOwner_ = dc;
+    }
+    else
+    {
+        for (const Rect& rect : dirtyRects_)
+        {
+            const D2D1_RECT_U dest = D2D1::RectU(static_cast<UINT32>(rect.left), static_cast<UINT32>(rect.top),
+                                                 static_cast<UINT32>(rect.right), static_cast<UINT32>(rect.bottom));
+            const std::uint32_t* source = pixels_.data() + static_cast<size_t>(rect.top) * static_cast<size_t>(width_) +
+                                          static_cast<size_t>(rect.left);
+            if (FAILED(bitmap_->CopyFromMemory(&dest, source, pitch)))
+            {
+                Invalidate(); // Upload everything again next frame
+            }
+        }
+    }
+
+    // Nearest-neighbour sampling keeps the stretched cells hard-edged
+    const Rect dest = DestRect(sceneRect, cellSize);
+    dc->DrawBitmap(bitmap_.Get(),
+                   D2D1::RectF(static_cast<float>(dest.left), static_cast<float>(dest.top),
+                               static_cast<float>(dest.right), static_cast<float>(dest.bottom)),
+                   1.0f, D2D1_BITMAP_INTERPOLATION_MODE_NEAREST_NEIGHBOR);
+}
+#endif
+
+} // namespace RainEngine
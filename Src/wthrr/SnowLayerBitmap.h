@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#ifdef _WIN32
+    #include <wrl/client.h>
+#endif
+
+#include "CoreTypes.h"
+#include "SettledSnow.h"
+
+// Forward declarations to keep Direct2D out of the simulation core
+struct ID2D1DeviceContext;
+struct ID2D1Bitmap;
+
+namespace RainEngine {
+
+class DrawRecorder;
+
+// Settled snow as one premultiplied BGRA image, one pixel per snow cell.
+//
+// Update compares every row whose change counter moved against a copy of
+// the cells last rasterized, rewrites only the pixels of words that differ
+// and collects the changed area as a short list of dirty rectangles.
+// The renderer uploads just those rectangles to a GPU bitmap and draws the
+// whole layer with a single blit, instead of one rectangle per snow run.
+// Everything but Draw is platform-neutral.
+class SnowLayerBitmap {
+public:
+    // Past this many dirty rectangles in one update they are merged into
+    // their bounding box; a few larger uploads beat many tiny ones
+    static constexpr size_t MAX_DIRTY_RECTS = 16;
+
+    SnowLayerBitmap() noexcept = default;
+
+    SnowLayerBitmap(const SnowLayerBitmap&) = delete;
+    SnowLayerBitmap& operator=(const SnowLayerBitmap&) = delete;
+
+    // Bring the pixels up to date with snow, drawing it in color. Returns
+    // the changed areas in cell coordinates (right and bottom exclusive);
+    // a resize or colour change marks the whole layer dirty.
+    const std::vector<Rect>& Update(const SettledSnow& snow, const Color& color);
+
+    // Dirty rectangles of the last Update
+    [[nodiscard]] const std::vector<Rect>& GetDirtyRects() const noexcept { return dirtyRects_; }
+
+    [[nodiscard]] int GetWidth() const noexcept { return width_; }
+    [[nodiscard]] int GetHeight() const noexcept { return height_; }
+    [[nodiscard]] const std::uint32_t* GetPixels() const noexcept { return pixels_.data(); }
+    [[nodiscard]] size_t GetPitch() const noexcept { return static_cast<size_t>(width_) * sizeof(std::uint32_t); }
+    [[nodiscard]] std::uint32_t GetPixel(int x, int y) const noexcept {
+        return pixels_[static_cast<size_t>(y) * static_cast<size_t>(width_) + static_cast<size_t>(x)];
+    }
+
+    // Force a full rewrite and upload on the next Update
+    void Invalidate() noexcept { valid_ = false; }
+
+    // Free the pixel memory and GPU bitmap, e.g. while the layer is not in use
+    void Release() noexcept;
+
+    // Update from the display's snow and record the blit Draw would make
+    void Record(DrawRecorder& recorder, const SettledSnow& snow, const Color& color, const Rect& sceneRect,
+                int cellSize = 1);
+
+    // Update from the display's snow, upload the dirty rectangles and draw
+    // the layer over sceneRect, stretching each cell to cellSize scene
+    // pixels. Recreates the GPU bitmap when needed.
+    void Draw(ID2D1DeviceContext* dc, const SettledSnow& snow, const Color& color, const Rect& sceneRect,
+              int cellSize = 1);
+
+private:
+    int width_ = 0;
+    int height_ = 0;
+    size_t wordsPerRow_ = 0;
+    std::uint32_t pixel_ = 0;  // Premultiplied BGRA of a snow cell
+    bool valid_ = false;
+
+    std::vector<std::uint32_t> pixels_;
+    std::vector<std::uint64_t> shadow_;        // Cells as last rasterized
+    std::vector<std::uint32_t> rowVersion_;    // Row counters as last rasterized
+    std::vector<std::uint64_t> rowWords_;      // One row of cells, read for a compare
+    std::vector<Rect> dirtyRects_;
+
+    // Where the layer lands on screen, each cell stretched to cellSize scene pixels
+    [[nodiscard]] Rect DestRect(const Rect& sceneRect, const int cellSize) const noexcept {
+        return {sceneRect.left, sceneRect.top, sceneRect.left + width_ * cellSize, sceneRect.top + height_ * cellSize};
+    }
+
+    #ifdef _WIN32
+    Microsoft::WRL::ComPtr<ID2D1Bitmap> bitmap_;
+    ID2D1DeviceContext* bitmapOwner_ = nullptr; // Context the bitmap was created on
+    #endif
+
+    void Resize(const SettledSnow& snow);
+    void RasterizeWord(int y, size_t wordIndex, std::uint64_t cells) noexcept;
+    void AddDirtyRow(int y, int left, int right);
+};
+
+} // namespace RainEngine
@@ -1,56 +1,135 @@
 #include "Splatter.h"
+#include "DrawRecorder.h"
 #include "MathUtil.h"
 #include "RandomGenerator.h"
 
-#include <d2d1.h>
+namespace RainEngine {
 
-Splatter::Splatter(DisplayData* pDispData, const Vector2 pos, const Vector2 vel) :
-	pDisplayData(pDispData), Pos(pos), Vel(vel)
+SplatterPool::SplatterPool(DisplayData* pDispData) noexcept
+    : pDisplayData(pDispData)
 {
-	// Create splatters with radius ranging from 1.0 to 2.0 pixels
-	Radius = (RandomGenerator::GetInstance().GenerateInt(15, 25) / 10.0f) * pDisplayData->ScaleFactor;
-	Pos.y = pos.y - Radius; // Slight adjustment
 }
 
-Splatter::~Splatter() = default;
+void SplatterPool::Reserve(const size_t capacity)
+{
+    if (capacity <= slots_.size()) return;
+
+    const size_t oldSize = slots_.size();
+    slots_.resize(capacity);
+    freeSlots_.reserve(capacity);
+
+    // Push new slots in reverse so the lowest index is handed out first
+    for (size_t i = capacity; i > oldSize; --i)
+    {
+        freeSlots_.push_back(static_cast<std::uint32_t>(i - 1));
+    }
+}
+
+void SplatterPool::Emit(const Vector2& pos, const Vector2& vel)
+{
+    if (freeSlots_.empty())
+    {
+        // Only grows until the pool covers the heaviest rain seen so far
+        Reserve(slots_.empty() ? 256 : slots_.size() * 2);
+    }
+
+    const std::uint32_t index = freeSlots_.back();
+    freeSlots_.pop_back();
+
+    Splatter& splatter = slots_[index];
+    splatter.Pos = pos;
+    splatter.Vel = vel;
+
+    // Create splatters with radius ranging from 1.0 to 2.0 pixels
+    splatter.Radius = (RandomGenerator::GetInstance().GenerateInt(15, 25) / 10.0f) * pDisplayData->ScaleFactor;
+    splatter.Pos.y = pos.y - splatter.Radius; // Slight adjustment
+
+    splatter.BounceCount = 0;
+    splatter.FrameCount = 0;
+    splatter.Active = true;
+    ++activeCount_;
+}
 
-void Splatter::UpdatePosition(const float deltaSeconds)
+void SplatterPool::Update(const float deltaSeconds) noexcept
 {
-	// Update the position of the raindrop
-	Pos.x += Vel.x * deltaSeconds;
-	Pos.y += Vel.y * deltaSeconds;
-
-	Vel.y += GRAVITY; // Gravity
-	Vel.x *= AIR_RESISTANCE; // Air Resistance
-
-	// Check for bouncing against sides
-	if (Pos.x + Radius > pDisplayData->SceneRect.right || Pos.x - Radius <
-		pDisplayData->SceneRect.left)
-	{
-		Vel.x = -Vel.x;
-	}
-	// Check for bouncing against bottom border
-	if (Pos.y + Radius > pDisplayData->SceneRect.bottom)
-	{
-		Pos.y = pDisplayData->SceneRect.bottom - Radius; // Keep the ellipse within bounds
-		Vel.y = -Vel.y * BOUNCE_DAMPING; // Bounce with damping
-		SplatterBounceCount++;
-	}
-	// Check for bouncing against top
-	if (Pos.y - Radius < pDisplayData->SceneRect.top)
-	{
-		Pos.y = Radius; // Keep the ellipse within bounds
-		Vel.y = -Vel.y; // Reverse the direction if it hits the top edge
-	}
+    if (activeCount_ == 0) return;
+
+    const Rect& sceneRect = pDisplayData->SceneRect;
+    const size_t count = slots_.size();
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        Splatter& splatter = slots_[i];
+        if (!splatter.Active) continue;
+
+        // Update the position of the splatter
+        splatter.Pos.x += splatter.Vel.x * deltaSeconds;
+        splatter.Pos.y += splatter.Vel.y * deltaSeconds;
+
+        splatter.Vel.y += GRAVITY; // Gravity
+        splatter.Vel.x *= AIR_RESISTANCE; // Air Resistance
+
+        // Check for bouncing against sides
+        if (splatter.Pos.x + splatter.Radius > sceneRect.right ||
+            splatter.Pos.x - splatter.Radius < sceneRect.left)
+        {
+            splatter.Vel.x = -splatter.Vel.x;
+        }
+        // Check for bouncing against bottom border
+        if (splatter.Pos.y + splatter.Radius > sceneRect.bottom)
+        {
+            splatter.Pos.y = sceneRect.bottom - splatter.Radius; // Keep the ellipse within bounds
+            splatter.Vel.y = -splatter.Vel.y * BOUNCE_DAMPING; // Bounce with damping
+            if (splatter.BounceCount < MAX_SPLATTER_BOUNCE_COUNT_)
+            {
+                splatter.BounceCount++;
+            }
+        }
+        // Check for bouncing against top
+        if (splatter.Pos.y - splatter.Radius < sceneRect.top)
+        {
+            splatter.Pos.y = splatter.Radius; // Keep the ellipse within bounds
+            splatter.Vel.y = -splatter.Vel.y; // Reverse the direction if it hits the top edge
+        }
+
+        // Recycle the slot once the splatter has fully faded
+        if (++splatter.FrameCount >= MAX_LIFETIME_FRAMES)
+        {
+            splatter.Active = false;
+            freeSlots_.push_back(static_cast<std::uint32_t>(i));
+            --activeCount_;
+        }
+    }
 }
 
-void Splatter::Draw(ID2D1DeviceContext* dc, ID2D1SolidColorBrush* pBrush) const
+void SplatterPool::Clear() noexcept
 {
-	if (MathUtil::IsPointInRect(pDisplayData->SceneRect, Pos) &&
-		SplatterBounceCount < MAX_SPLATTER_BOUNCE_COUNT_)
-	{
-		// Define the ellipse with center at (posX, posY) and radius 5px
-		const D2D1_ELLIPSE ellipse = D2D1::Ellipse(D2D1::Point2F(Pos.x, Pos.y), Radius, Radius);
-		dc->FillEllipse(ellipse, pBrush);
-	}
+    freeSlots_.clear();
+    for (size_t i = slots_.size(); i > 0; --i)
+    {
+        slots_[i - 1].Active = false;
+        freeSlots_.push_back(static_cast<std::uint32_t>(i - 1));
+    }
+    activeCount_ = 0;
 }
+
+void SplatterPool::Record(DrawRecorder& recorder) const
+{
+    if (activeCount_ == 0) return;
+
+    const Rect& sceneRect = pDisplayData->SceneRect;
+    for (const Splatter& splatter : slots_)
+    {
+        if (splatter.Active &&
+            splatter.BounceCount < MAX_SPLATTER_BOUNCE_COUNT_ &&
+            MathUtil::IsPointInRect(sceneRect, splatter.Pos))
+        {
+            // Splatters fade out over their lifetime
+            const float opacity =
+                (1.0f - static_cast<float>(splatter.FrameCount) / static_cast<float>(MAX_LIFETIME_FRAMES)) * 0.75f;
+            recorder.FillEllipse(splatter.Pos.ToPoint(), splatter.Radius, splatter.Radius, opacity);
+        }
+    }
+}
+
+} // namespace RainEngine
@@ -1,30 +1,71 @@
 #pragma once
 
+#include <cstdint>
+#include <vector>
+
 #include "Vector2.h"
 #include "DisplayData.h"
 
-// RainDrop Class
-class Splatter
-{
+namespace RainEngine {
+
+class DrawRecorder;
+
+// One splatter droplet thrown up when a rain drop hits the ground.
+// Plain data so the pool can store splatters by value in one flat array.
+struct Splatter {
+    Vector2 Pos;
+    Vector2 Vel;
+    float Radius = 0.0f;
+    std::uint8_t BounceCount = 0;
+    std::uint8_t FrameCount = 0; // Steps since the splatter was emitted, selects the fade brush
+    bool Active = false;
+};
+
+// Per-display owner of every live splatter. Slots live in one flat array and
+// are recycled through a free list, so ground hits write into pre-reserved
+// storage instead of allocating, and update/draw are a single pass.
+class SplatterPool {
 public:
-	Splatter(DisplayData* pDispData, Vector2 pos, Vector2 vel);
-	~Splatter();
+    // Number of steps a splatter lives and fades over
+    static constexpr int MAX_LIFETIME_FRAMES = 50;
 
-	void UpdatePosition(float deltaSeconds);
-	void Draw(ID2D1DeviceContext* dc, ID2D1SolidColorBrush* pBrush) const;
+    explicit SplatterPool(DisplayData* pDispData) noexcept;
+    ~SplatterPool() noexcept = default;
 
-private:
-	static constexpr int MAX_SPLATTER_BOUNCE_COUNT_ = 2;
+    SplatterPool(const SplatterPool&) = delete;
+    SplatterPool& operator=(const SplatterPool&) = delete;
+
+    // Take a free slot for a new splatter at pos moving with vel
+    void Emit(const Vector2& pos, const Vector2& vel);
 
-	static constexpr float GRAVITY = 10.0f; // pixels per second square
-	static constexpr float AIR_RESISTANCE = 0.98f; // pixels per second square
-	static constexpr float BOUNCE_DAMPING = 0.9f;
+    // Advance every live splatter by deltaSeconds and recycle the expired ones
+    void Update(float deltaSeconds) noexcept;
 
-	DisplayData* pDisplayData;
+    void Clear() noexcept;
+    void Reserve(size_t capacity);
 
-	Vector2 Pos;
-	Vector2 Vel;
-	float Radius;
+    [[nodiscard]] size_t ActiveCount() const noexcept { return activeCount_; }
+    [[nodiscard]] size_t Capacity() const noexcept { return slots_.size(); }
 
-	int SplatterBounceCount = 0;
+    // The visible splatters, fading over their lifetime; drawn with the rain
+    void Record(DrawRecorder& recorder) const;
+
+private:
+    static constexpr int MAX_SPLATTER_BOUNCE_COUNT_ = 2;
+
+    static constexpr float GRAVITY = 10.0f; // pixels per second square
+    static constexpr float AIR_RESISTANCE = 0.98f; // pixels per second square
+    static constexpr float BOUNCE_DAMPING = 0.9f;
+
+    DisplayData* pDisplayData; // Non-owning pointer
+
+    std::vector<Splatter> slots_;
+    std::vector<std::uint32_t> freeSlots_;
+    size_t activeCount_ = 0;
 };
+
+} // namespace RainEngine
+
+// Global aliases matching the other engine types
+using Splatter = RainEngine::Splatter;
+using SplatterPool = RainEngine::SplatterPool;
@@ -12,7 +12,10 @@
 #include <iostream>
 #include <string>
 #include <cstdio>
-#include <d2d1_1.h>
+#ifdef _WIN32
+    #include <d2d1_1.h>
+#endif
+#include "CoreTypes.h"
 
 namespace RainEngine {
 
@@ -167,6 +170,12 @@ public:
         return {std::clamp(x, minValue, maxValue), std::clamp(y, minValue, maxValue)};
     }
 
+    // Core point conversion
+    [[nodiscard]] constexpr PointF ToPoint() const noexcept {
+        return {x, y};
+    }
+
+    #ifdef _WIN32
     // DirectX integration
     [[nodiscard]] D2D1_POINT_2F ToD2DPoint() const noexcept {
         return D2D1::Point2F(x, y);
@@ -175,6 +184,7 @@ public:
     [[nodiscard]] static constexpr Vector2 FromD2DPoint(const D2D1_POINT_2F& point) noexcept {
         return {point.x, point.y};
     }
+    #endif
 
     // String representation with fallback for std::format compatibility
     [[nodiscard]] std::string ToString() const {
@@ -0,0 +1,335 @@
+#include "WeatherSimulation.h"
+
+#include <cmath>
+
+#include "RandomGenerator.h"
+
+namespace RainEngine {
+
+WeatherSimulation::WeatherSimulation(DisplayData* pDispData, const Setting* pGeneralSettings)
+    : pDisplayData(pDispData), pSettings(pGeneralSettings), Rain(pDispData), Snow(pDispData),
+      LastParticleType(pGeneralSettings->PartType)
+{
+    // Initialize puddle manager
+    pPuddleManager = std::make_unique<PuddleManager>(pDisplayData);
+
+    // Initialize snow wind system with default values
+    CurrentSnowWindDirection = 0.0f;
+    TargetSnowWindDirection = 0.0f;
+    WindTransitionProgress = 1.0f;
+    LastWindChangeTime = SimulationTime;
+    NextWindChangeTime = LastWindChangeTime + 5.0; // First change in 5 seconds
+}
+
+WeatherSimulation::~WeatherSimulation() = default;
+
+int WeatherSimulation::Advance(const SimulationClock& clock)
+{
+    // One spawn budget for the whole frame: a normal frame's worth of steps,
+    // so catch-up and fast-forward steps do not multiply the spawns
+    RainEmitter.BeginFrame(clock.GetMaxStepsPerFrame());
+    SnowEmitter.BeginFrame(clock.GetMaxStepsPerFrame());
+
+    const int stepCount = clock.GetFrameSteps();
+    for (int step = 0; step < stepCount; ++step)
+    {
+        Step(clock.GetStepSeconds(), clock.GetStepIndex(step), clock.GetStepTime(step));
+    }
+    return stepCount;
+}
+
+void WeatherSimulation::Step(const float deltaTime, const std::uint64_t stepIndex, const double time)
+{
+    // Lightning, wind and settling are timed by the clock's steps, not the wall clock
+    SimulationTime = time;
+    StepIndex = stepIndex;
+
+    // Update particle systems with fixed time step
+    if (pSettings->PartType == RAIN)
+    {
+        // Settled snow does not survive a switch to rain; give its memory back
+        if (LastParticleType == SNOW)
+        {
+            ClearSnow();
+        }
+        UpdateRainDrops(deltaTime);
+    }
+    else if (pSettings->PartType == SNOW)
+    {
+        // Update snow wind system if enabled
+        if (pSettings->EnableSnowWind)
+        {
+            UpdateSnowWind(deltaTime);
+        }
+
+        UpdateSnowFlakes(deltaTime);
+    }
+
+    LastParticleType = pSettings->PartType;
+
+    // Update lightning flash system
+    UpdateLightning();
+}
+
+void WeatherSimulation::ClearRainDrops() noexcept
+{
+    Rain.Clear();
+    RainEmitter.Reset();
+}
+
+void WeatherSimulation::ClearSnow() noexcept
+{
+    Snow.Clear();
+    SnowEmitter.Reset();
+    pDisplayData->ReleaseSettledSnow();
+}
+
+void WeatherSimulation::ResetPuddles() noexcept
+{
+    if (pPuddleManager)
+    {
+        pPuddleManager->Reset();
+    }
+}
+
+void WeatherSimulation::SetSpawnRate(const ParticleType type, const float particlesPerSecond) noexcept
+{
+    if (type == RAIN)
+    {
+        RainSpawnRate = particlesPerSecond;
+    }
+    else
+    {
+        SnowSpawnRate = particlesPerSecond;
+    }
+}
+
+void WeatherSimulation::UpdateRainDrops(const float deltaTime)
+{
+    // Move each raindrop to the next point
+    Rain.Update(deltaTime);
+
+    // Drain this step's ground hits into the puddles, then update them with the same time delta
+    if (pPuddleManager)
+    {
+        pPuddleManager->AddGroundHits(Rain.GetGroundHits());
+        pPuddleManager->Update(deltaTime);
+    }
+
+    // Remove all raindrops that have expired
+    Rain.RemoveDead();
+
+    // Calculate the number of raindrops to generate, spread over several steps
+    const size_t maxFallingDrops = static_cast<size_t>(pSettings->MaxParticles) * 3;
+    if (RainSpawnRate > 0.0f)
+    {
+        RainEmitter.SetRate(RainSpawnRate, maxFallingDrops);
+    }
+    else
+    {
+        RainEmitter.SetRefillToCap(maxFallingDrops, RAIN_SPAWN_RAMP_STEPS);
+    }
+    const int noOfDropsToGenerate = RainEmitter.Schedule(Rain.GetFallingCount(), deltaTime);
+
+    // Generate new raindrops
+    Rain.Spawn(noOfDropsToGenerate, pSettings->WindSpeed);
+}
+
+void WeatherSimulation::UpdateSnowFlakes(const float deltaTime)
+{
+    // Added 12/25/2024 - Todd D
+    // rate of snow fall *100 added
+    const size_t maxFlakes = static_cast<size_t>(pSettings->MaxParticles) * 100;
+
+    if (Snow.Size() > maxFlakes)
+    {
+        // Flakes are interchangeable, so trim the surplus from the back
+        Snow.Truncate(maxFlakes);
+    }
+    else
+    {
+        // Spread new flakes over several steps instead of one large burst
+        if (SnowSpawnRate > 0.0f)
+        {
+            SnowEmitter.SetRate(SnowSpawnRate, maxFlakes);
+        }
+        else
+        {
+            SnowEmitter.SetRefillToCap(maxFlakes, SNOW_SPAWN_RAMP_STEPS);
+        }
+        const int noOfFlakesToGenerate = SnowEmitter.Schedule(Snow.Size(), deltaTime);
+
+        Snow.Reserve(maxFlakes);
+        Snow.Spawn(noOfFlakesToGenerate);
+    }
+
+    // Apply wind to horizontal velocity if snow wind is enabled
+    const float snowWindFactor = GetCurrentSnowWindFactor();
+    if (pSettings->EnableSnowWind && snowWindFactor != 0.0f)
+    {
+        Snow.ApplyWind(snowWindFactor, deltaTime);
+    }
+
+    // Move each snowflake to the next point, settling the ones that reach the snow
+    Snow.Update(deltaTime);
+    SnowFlake::SettleSnow(pDisplayData, StepIndex);
+}
+
+void WeatherSimulation::UpdateLightning()
+{
+    // Only enable lightning during rain, not snow
+    if (pSettings->PartType != RAIN)
+    {
+        LightningFlashIntensity = 0.0f;
+        LightningFlashFramesRemaining = 0;
+        return;
+    }
+
+    const double currentTime = SimulationTime;
+    auto& rng = RandomGenerator::GetInstance();
+
+    // Initialize lightning timing on first run
+    if (NextLightningTime == 0.0)
+    {
+        // First lightning strike between 5-15 seconds, adjusted by frequency setting
+        const double frequencyMultiplier = (101 - pSettings->LightningFrequency) / 100.0; // Higher setting = more frequent
+        NextLightningTime = currentTime + (5.0 + rng.GenerateInt(0, 9)) * frequencyMultiplier;
+    }
+
+    // Check if it's time for lightning
+    if (currentTime >= NextLightningTime)
+    {
+        // Trigger lightning flash with user-configurable intensity
+        const float baseIntensity = 0.05f + (pSettings->LightningIntensity / 100.0f) * 0.3f; // 0.05-0.35 range
+        LightningFlashIntensity = baseIntensity + rng.GenerateInt(0, 4) * 0.01f; // Add small random variation
+        LightningFlashFramesRemaining = 3 + rng.GenerateInt(0, 3); // 3-6 frames duration
+
+        // Schedule next lightning with frequency setting (5-60 seconds range)
+        const double frequencyMultiplier = (101 - pSettings->LightningFrequency) / 100.0; // Higher setting = more frequent
+        const double baseInterval = 5.0 + rng.GenerateInt(0, 24); // 5-30 seconds base
+        LastLightningTime = currentTime;
+        NextLightningTime = currentTime + baseInterval * frequencyMultiplier;
+    }
+
+    // Fade out lightning flash
+    if (LightningFlashFramesRemaining > 0)
+    {
+        LightningFlashFramesRemaining--;
+        if (LightningFlashFramesRemaining == 0)
+        {
+            LightningFlashIntensity = 0.0f;
+        }
+        else
+        {
+            // Exponential fade out
+            LightningFlashIntensity *= 0.7f;
+        }
+    }
+}
+
+void WeatherSimulation::UpdateSnowWind(const float deltaTime)
+{
+    const double currentTime = SimulationTime;
+    
+    // Check if it's time to change the wind direction
+    if (currentTime >= NextWindChangeTime)
+    {
+        // Calculate how often the wind changes based on variability (0-100)
+        // Higher variability means more frequent changes (2-15 seconds)
+        // Reduced minimum time slightly to make wind changes more noticeable
+        const float variabilityFactor = pSettings->SnowWindVariability / 100.0f;
+        const float changeDuration = 15.0f - (variabilityFactor * 13.0f);  // 2-15 seconds
+        
+        // Calculate how strong the wind is based on intensity (0-100)
+        // Higher intensity means stronger wind (-8 to 8) - increased range for visibility
+        // Increased the strength range from 4.0 to 8.0 to make wind more noticeable
+        const float intensityFactor = pSettings->SnowWindIntensity / 100.0f;
+        const float maxWindStrength = 8.0f * intensityFactor;
+        
+        // Set the previous and target wind directions
+        CurrentSnowWindDirection = TargetSnowWindDirection;
+        
+        // Generate a new target wind direction with more dramatic shifts
+        auto& rng = RandomGenerator::GetInstance();
+        
+        // Make wind changes more dramatic by having more variance between directions
+        // Reduced continuity factor to allow more dramatic shifts
+        const float windContinuityFactor = 0.1f;  // Reduced from 0.3 for more dramatic shifts
+        
+        // Make wind shifts more pronounced by sometimes forcing direction change
+        // If the current wind is weak or we need a dramatic change
+        if (fabsf(CurrentSnowWindDirection) < 1.0f || rng.GenerateFloat(0.0f, 1.0f) < 0.3f) {
+            // Create more dramatic wind shift
+            const float randomComponent = rng.GenerateFloat(-maxWindStrength, maxWindStrength);
+            // Force wind to blow in a more noticeable direction, avoiding near-zero values
+            if (fabsf(randomComponent) < 2.0f) {
+                TargetSnowWindDirection = randomComponent > 0 ? 2.0f : -2.0f;
+            } else {
+                TargetSnowWindDirection = randomComponent;
+            }
+        }
+        else {
+            // Normal wind shift with some continuity
+            const float randomComponent = rng.GenerateFloat(-maxWindStrength, maxWindStrength);
+            TargetSnowWindDirection = (CurrentSnowWindDirection * windContinuityFactor) + 
+                                      (randomComponent * (1.0f - windContinuityFactor));
+        }
+        
+        // Cap the target wind strength
+        if (TargetSnowWindDirection > maxWindStrength)
+            TargetSnowWindDirection = maxWindStrength;
+        if (TargetSnowWindDirection < -maxWindStrength)
+            TargetSnowWindDirection = -maxWindStrength;
+        
+        // Reset transition progress
+        WindTransitionProgress = 0.0f;
+        
+        // Schedule next wind change with some randomness for natural variation
+        LastWindChangeTime = currentTime;
+        NextWindChangeTime = currentTime + changeDuration + (rng.GenerateFloat(-2.0f, 2.0f));
+    }
+    
+    // Update wind transition - slightly faster transitions for more noticeable effect
+    if (WindTransitionProgress < 1.0f)
+    {
+        // Transition more quickly for more dramatic wind changes
+        // Increased transition speed for more visible changes
+        float transitionSpeed = 0.3f + 
+                               (pSettings->SnowWindVariability / 100.0f * 0.4f);
+        
+        WindTransitionProgress += deltaTime * transitionSpeed;
+        if (WindTransitionProgress > 1.0f)
+        {
+            WindTransitionProgress = 1.0f;
+        }
+    }
+}
+
+float WeatherSimulation::GetCurrentSnowWindFactor() const
+{
+    if (!pSettings->EnableSnowWind)
+    {
+        return 0.0f;
+    }
+    
+    // Use smooth transition between wind directions
+    const float t = WindTransitionProgress;
+    
+    // Modified easing function for more dramatic initial and final movements
+    // This makes wind changes more noticeable at start and end of transition
+    float easedT;
+    if (t < 0.5f) {
+        // Sharper initial acceleration (more noticeable start)
+        easedT = 2.0f * t * t;
+    }
+    else {
+        // Sharper deceleration at the end (more noticeable finish)
+        const float f = (1.0f - t);
+        easedT = 1.0f - 2.0f * f * f;
+    }
+    
+    // Interpolate between current and target wind directions
+    return CurrentSnowWindDirection * (1.0f - easedT) + TargetSnowWindDirection * easedT;
+}
+
+} // namespace RainEngine
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <memory>
+
+#include "DisplayData.h"
+#include "Settings.h"
+#include "ParticleEmitter.h"
+#include "RainField.h"
+#include "SnowField.h"
+#include "SnowFlake.h"
+#include "Puddle.h"
+#include "SimulationClock.h"
+
+namespace RainEngine {
+
+// Platform-neutral per-display weather simulation. Owns the particles, puddles,
+// lightning and snow wind state for one display and advances them by the fixed
+// steps of a SimulationClock. DisplayWindow drives it from the Win32 frame loop
+// and draws its state; the headless driver steps it directly.
+class WeatherSimulation {
+public:
+    // Steps over which an empty scene is refilled to the particle cap
+    static constexpr int RAIN_SPAWN_RAMP_STEPS = 30;
+    static constexpr int SNOW_SPAWN_RAMP_STEPS = 120;
+
+    WeatherSimulation(DisplayData* pDispData, const Setting* pGeneralSettings);
+    ~WeatherSimulation();
+
+    WeatherSimulation(const WeatherSimulation&) = delete;
+    WeatherSimulation& operator=(const WeatherSimulation&) = delete;
+
+    // Run the steps the clock handed out for this frame, spawning at most
+    // GetMaxStepsPerFrame steps' worth of particles however many that is.
+    // Returns the number of steps taken.
+    int Advance(const SimulationClock& clock);
+
+    // Run exactly one fixed step of every active subsystem: step stepIndex
+    // of the clock, ending at simulation time seconds
+    void Step(float deltaTime, std::uint64_t stepIndex, double time);
+
+    // Drop all falling rain and puddles, e.g. after the scene bounds change
+    void ClearRainDrops() noexcept;
+    void ResetPuddles() noexcept;
+
+    // Drop all flakes and settled snow and free their memory
+    void ClearSnow() noexcept;
+
+    // Emit particles at a steady rate instead of refilling to the cap.
+    // A rate of zero or less restores refill-to-cap.
+    void SetSpawnRate(ParticleType type, float particlesPerSecond) noexcept;
+
+    [[nodiscard]] const RainField& GetRainField() const noexcept { return Rain; }
+    [[nodiscard]] const SnowField& GetSnowField() const noexcept { return Snow; }
+    [[nodiscard]] PuddleManager* GetPuddleManager() const noexcept { return pPuddleManager.get(); }
+    [[nodiscard]] float GetLightningFlashIntensity() const noexcept { return LightningFlashIntensity; }
+    [[nodiscard]] float GetCurrentSnowWindFactor() const;
+    [[nodiscard]] const ParticleEmitter& GetRainEmitter() const noexcept { return RainEmitter; }
+    [[nodiscard]] const ParticleEmitter& GetSnowEmitter() const noexcept { return SnowEmitter; }
+
+    // Simulation time at the end of the last step
+    [[nodiscard]] double GetSimulationTime() const noexcept { return SimulationTime; }
+
+private:
+    DisplayData* pDisplayData; // Non-owning pointer
+    const Setting* pSettings;  // Non-owning pointer, shared by all displays
+
+    RainField Rain;
+    SnowField Snow;
+    std::unique_ptr<PuddleManager> pPuddleManager;
+
+    // Spawn scheduling; caps follow MaxParticles every step
+    ParticleEmitter RainEmitter;
+    ParticleEmitter SnowEmitter;
+    float RainSpawnRate = 0.0f;
+    float SnowSpawnRate = 0.0f;
+
+    // Simulation time and clock step number of the step being run
+    double SimulationTime = 0.0;
+    std::uint64_t StepIndex = 0;
+
+    // Weather of the previous step, to notice a switch from snow to rain
+    ParticleType LastParticleType;
+
+    // Lightning flash system
+    double LastLightningTime = 0.0;
+    double NextLightningTime = 0.0;
+    float LightningFlashIntensity = 0.0f;
+    int LightningFlashFramesRemaining = 0;
+
+    // Snow wind system
+    double LastWindChangeTime = 0.0;
+    double NextWindChangeTime = 0.0;
+    float CurrentSnowWindDirection = 0.0f;
+    float TargetSnowWindDirection = 0.0f;
+    float WindTransitionProgress = 1.0f;
+
+    void UpdateRainDrops(float deltaTime);
+    void UpdateSnowFlakes(float deltaTime);
+    void UpdateLightning();
+    void UpdateSnowWind(float deltaTime);
+};
+
+} // namespace RainEngine
@@ -0,0 +1,33 @@
+#pragma once
+
+// Conversions between the platform-neutral core types and their Win32 /
+// Direct2D equivalents. Only the Windows renderer includes this header.
+
+#include <windows.h>
+#include <d2d1.h>
+#include "CoreTypes.h"
+
+namespace RainEngine {
+
+[[nodiscard]] inline Rect ToRect(const RECT& rect) noexcept {
+    return {
+        static_cast<std::int32_t>(rect.left),
+        static_cast<std::int32_t>(rect.top),
+        static_cast<std::int32_t>(rect.right),
+        static_cast<std::int32_t>(rect.bottom)
+    };
+}
+
+[[nodiscard]] inline RECT ToRECT(const Rect& rect) noexcept {
+    return {rect.left, rect.top, rect.right, rect.bottom};
+}
+
+[[nodiscard]] inline D2D1_POINT_2F ToD2DPoint(const PointF& point) noexcept {
+    return D2D1::Point2F(point.x, point.y);
+}
+
+[[nodiscard]] inline D2D1_COLOR_F ToD2DColor(const Color& color) noexcept {
+    return D2D1::ColorF(color.r, color.g, color.b, color.a);
+}
+
+} // namespace RainEngine
@@ -0,0 +1,130 @@
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+namespace RainEngine {
+
+namespace {
+
+std::mutex g_sharedMutex;
+std::unique_ptr<WorkerPool> g_sharedPool;
+
+} // namespace
+
+WorkerPool::WorkerPool(const size_t workerThreads)
+{
+    workers_.reserve(workerThreads);
+    for (size_t i = 0; i < workerThreads; ++i)
+    {
+        workers_.emplace_back(&WorkerPool::WorkerMain, this, i + 1);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_)
+    {
+        worker.join();
+    }
+}
+
+void WorkerPool::ParallelFor(const size_t count, const ItemFunction& fn)
+{
+    std::lock_guard loopLock(loopMutex_);
+
+    // Nothing to share out
+    if (workers_.empty() || count <= 1)
+    {
+        for (size_t item = 0; item < count; ++item)
+        {
+            fn(item, 0);
+        }
+        return;
+    }
+
+    std::unique_lock lock(mutex_);
+    fn_ = &fn;
+    count_ = count;
+    next_ = 0;
+    pending_ = count;
+    error_ = nullptr;
+    ++generation_;
+    wake_.notify_all();
+
+    RunItems(0, lock);
+    done_.wait(lock, [this] { return pending_ == 0; });
+    fn_ = nullptr;
+
+    if (error_)
+    {
+        std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+}
+
+void WorkerPool::RunItems(const size_t thread, std::unique_lock<std::mutex>& lock)
+{
+    while (next_ < count_)
+    {
+        const size_t item = next_++;
+        const ItemFunction& fn = *fn_;
+        lock.unlock();
+        std::exception_ptr error;
+        try
+        {
+            fn(item, thread);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+        lock.lock();
+
+        if (error && !error_)
+        {
+            error_ = error;
+        }
+        if (--pending_ == 0)
+        {
+            done_.notify_one();
+        }
+    }
+}
+
+void WorkerPool::WorkerMain(const size_t thread)
+{
+    std::unique_lock lock(mutex_);
+    size_t seen = generation_;
+    for (;;)
+    {
+        wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+        if (stop_) return;
+        seen = generation_;
+        RunItems(thread, lock);
+    }
+}
+
+WorkerPool& WorkerPool::Shared()
+{
+    std::lock_guard lock(g_sharedMutex);
+    if (!g_sharedPool)
+    {
+        const size_t hardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+        g_sharedPool = std::make_unique<WorkerPool>(hardwareThreads - 1);
+    }
+    return *g_sharedPool;
+}
+
+void WorkerPool::SetSharedWorkerThreads(const size_t workerThreads)
+{
+    std::lock_guard lock(g_sharedMutex);
+    g_sharedPool = std::make_unique<WorkerPool>(workerThreads);
+}
+
+} // namespace RainEngine
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace RainEngine {
+
+// A fixed set of worker threads for data-parallel loops.
+//
+// ParallelFor hands out the items of one loop to the workers and the calling
+// thread, and returns once every item is done. Each call passes the index of
+// the thread running the item, in [0, GetThreadCount()), so callers can give
+// every thread its own scratch space. Loops from different threads are run
+// one after the other.
+class WorkerPool {
+public:
+    using ItemFunction = std::function<void(size_t item, size_t thread)>;
+
+    // workerThreads threads besides the caller; 0 runs every loop inline
+    explicit WorkerPool(size_t workerThreads);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Threads that may run items, the caller included
+    [[nodiscard]] size_t GetThreadCount() const noexcept { return workers_.size() + 1; }
+
+    // Run fn for every item in [0, count). The first exception thrown by an
+    // item is rethrown here once the loop has finished.
+    void ParallelFor(size_t count, const ItemFunction& fn);
+
+    // Pool shared by the simulation, one worker less than the hardware threads
+    [[nodiscard]] static WorkerPool& Shared();
+
+    // Replace the shared pool; only while no loop is running on it
+    static void SetSharedWorkerThreads(size_t workerThreads);
+
+private:
+    std::vector<std::thread> workers_;
+    std::mutex loopMutex_; // Serializes ParallelFor calls
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    const ItemFunction* fn_ = nullptr;
+    size_t count_ = 0;
+    size_t next_ = 0;
+    size_t pending_ = 0;
+    size_t generation_ = 0;
+    bool stop_ = false;
+    std::exception_ptr error_;
+
+    void WorkerMain(size_t thread);
+    void RunItems(size_t thread, std::unique_lock<std::mutex>& lock);
+};
+
+} // namespace RainEngine